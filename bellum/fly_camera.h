@@ -59,6 +59,25 @@ public:
       Input::setMouseLocked(false);
     }
   }
+
+  // Turns the rendered view by the cursor movement since the tick, update applies it for real
+  void latch() override {
+    Camera* camera = node_->getComponent<Camera>();
+    if (camera == nullptr) {
+      return;
+    }
+
+    Vector2 mouseDelta = Input::mouseLocked() ? Input::lateMouseDelta() : Vector2{};
+    Transform* t = &node_->transform();
+    float dt = Time::deltaTime();
+
+    Quaternion yaw = Quaternion::makeEuler<Precision::FAST>(
+      {0.0f, mouseDelta.x * kMouseSensitivity * dt, 0.0f});
+    Vector3 right = yaw * t->right();
+    Quaternion pitch =
+      Quaternion::makeAngleAxis<Precision::FAST>(mouseDelta.y * kMouseSensitivity * dt, right);
+    camera->setLateRotation(pitch * yaw);
+  }
 };
 
 #endif
@@ -28,9 +28,7 @@ public:
 
     Mesh* mesh = MeshFactory::makeCube({AttributeKind::POSITION, AttributeKind::COLOR}, 1, 1, 1);
     std::vector<Color> colors = mesh->colors();
-    for(uint32 i = 0; i < colors.size(); i++) {
-      colors[i] = Random::color();
-    }
+    Random::generator().fill(colors.data(), colors.size());
     mesh->setColors(colors);
     mesh->uploadMeshData(true);
 
@@ -0,0 +1,117 @@
+#include "benchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include "math/simd.h"
+
+namespace bellum {
+
+namespace {
+
+double elapsedNanoseconds(const std::function<void(uint64)>& loop, uint64 calls) {
+  auto start = std::chrono::steady_clock::now();
+  loop(calls);
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+uint64 calibrate(const std::function<void(uint64)>& loop, double sampleNs) {
+  // grow until one run fills the sample time, this doubles as the warmup
+  uint64 calls = 1;
+  for (;;) {
+    double ns = elapsedNanoseconds(loop, calls);
+    if (ns >= sampleNs) {
+      return calls;
+    }
+
+    double scale = ns > 0.0 ? sampleNs / ns * 1.2 : 10.0;
+    calls = static_cast<uint64>(calls * std::min(std::max(scale, 2.0), 10.0));
+  }
+}
+
+}
+
+std::vector<Benchmark::Result> Benchmark::run(const Options& options) const {
+  std::vector<Result> results;
+  std::vector<double> samples(std::max<uint32>(options.samples, 1));
+
+  for (const auto& c : cases_) {
+    if (!options.filter.empty() && c.name.find(options.filter) == std::string::npos) {
+      continue;
+    }
+
+    uint64 calls = calibrate(c.loop, options.sample_ms * 1000000.0);
+    uint64 ops = calls * c.ops_per_call;
+
+    for (auto& sample : samples) {
+      sample = elapsedNanoseconds(c.loop, calls) / ops;
+    }
+
+    double mean = 0.0;
+    for (double sample : samples) {
+      mean += sample;
+    }
+    mean /= samples.size();
+
+    double variance = 0.0;
+    for (double sample : samples) {
+      variance += (sample - mean) * (sample - mean);
+    }
+    variance = samples.size() > 1 ? variance / (samples.size() - 1) : 0.0;
+
+    std::vector<double> sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+
+    results.push_back({
+      c.name,
+      ops,
+      mean,
+      sorted.front(),
+      sorted[sorted.size() / 2],
+      variance,
+      mean > 0.0 ? 1000000000.0 / mean : 0.0
+    });
+  }
+
+  return results;
+}
+
+void Benchmark::writeJson(std::ostream& out, const Options& options,
+                          const std::vector<Result>& results) {
+  out << "{\n  \"samples\": " << options.samples << ",\n  \"sample_ms\": " << options.sample_ms
+#ifdef BELLUM_SIMD_SSE
+      << ",\n  \"simd\": \"sse\""
+#else
+      << ",\n  \"simd\": \"none\""
+#endif
+      << ",\n  \"benchmarks\": [";
+
+  for (size_t i = 0; i < results.size(); i++) {
+    const Result& r = results[i];
+    out << (i == 0 ? "\n" : ",\n");
+    out << "    {\"name\": \"" << r.name << "\", "
+        << "\"ops_per_sample\": " << r.ops_per_sample << ", "
+        << "\"ns_per_op\": " << r.ns_per_op << ", "
+        << "\"ns_min\": " << r.ns_min << ", "
+        << "\"ns_median\": " << r.ns_median << ", "
+        << "\"ns_variance\": " << r.ns_variance << ", "
+        << "\"ops_per_second\": " << r.ops_per_second << "}";
+  }
+
+  out << "\n  ]\n}\n";
+}
+
+void Benchmark::writeTable(std::ostream& out, const std::vector<Result>& results) {
+  out << std::left << std::setw(40) << "name" << std::right << std::setw(12) << "ns/op"
+      << std::setw(12) << "stddev" << std::setw(16) << "ops/s" << '\n';
+
+  for (const auto& r : results) {
+    out << std::left << std::setw(40) << r.name << std::right << std::fixed
+        << std::setprecision(3) << std::setw(12) << r.ns_per_op
+        << std::setw(12) << std::sqrt(r.ns_variance)
+        << std::setprecision(0) << std::setw(16) << r.ops_per_second << '\n';
+  }
+}
+
+}
@@ -0,0 +1,77 @@
+#ifndef BELLUM_BENCHMARK_H
+#define BELLUM_BENCHMARK_H
+
+#include <functional>
+#include <ostream>
+#include "common.h"
+
+namespace bellum {
+
+// Runs registered cases in timed samples. The iteration count of a sample is calibrated once so
+// it takes about 'sample_ms', then every sample runs that many iterations and the spread between
+// samples becomes the variance.
+class Benchmark {
+public:
+  struct Options {
+    uint32 samples = 15;
+    double sample_ms = 10.0;
+    // Only cases whose name contains this run
+    std::string filter;
+  };
+
+  // Times are per single operation
+  struct Result {
+    std::string name;
+    uint64 ops_per_sample;
+    double ns_per_op;
+    double ns_min;
+    double ns_median;
+    double ns_variance;
+    double ops_per_second;
+  };
+
+  // Registers a case, 'fn' performs 'opsPerCall' operations every time it is called
+  template<typename F>
+  inline void add(const std::string& name, uint32 opsPerCall, F fn);
+
+  std::vector<Result> run(const Options& options) const;
+
+  static void writeJson(std::ostream& out, const Options& options,
+                        const std::vector<Result>& results);
+  static void writeTable(std::ostream& out, const std::vector<Result>& results);
+
+  // Keeps the compiler from discarding a computed value or hoisting work out of the timed loop
+  template<typename T>
+  static inline void keep(const T& value);
+
+private:
+  struct Case {
+    std::string name;
+    uint32 ops_per_call;
+    std::function<void(uint64)> loop;
+  };
+
+  std::vector<Case> cases_;
+};
+
+// Suites, one per source file
+void addMathBenchmarks(Benchmark& benchmark);
+
+template<typename F>
+inline void Benchmark::add(const std::string& name, uint32 opsPerCall, F fn) {
+  // the loop lives in the lambda so fn is inlined into it
+  cases_.push_back({name, opsPerCall, [fn](uint64 calls) mutable {
+    for (uint64 i = 0; i < calls; i++) {
+      fn();
+    }
+  }});
+}
+
+template<typename T>
+inline void Benchmark::keep(const T& value) {
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+}
+
+#endif
@@ -0,0 +1,62 @@
+#include <fstream>
+#include <iostream>
+#include "benchmark.h"
+
+using namespace bellum;
+
+// Writes JSON results to stdout, or to the file given with '--out=', and a readable table to
+// stderr. Other options are '--filter=', '--samples=' and '--sample-ms='.
+int main(int argc, char** argv) {
+  Benchmark::Options options;
+  std::string outPath;
+  {
+    // parse '--x=y' arguments
+    std::stringstream ss;
+
+    for (int32 i = 1; i < argc; i++) {
+      std::string arg = argv[i];
+      if (arg.compare(0, 9, "--filter=") == 0) {
+        options.filter = arg.substr(9);
+        continue;
+      } else if (arg.compare(0, 6, "--out=") == 0) {
+        outPath = arg.substr(6);
+        continue;
+      } else if (arg.compare(0, 10, "--samples=") == 0) {
+        ss.str(arg.substr(10));
+        ss >> options.samples;
+      } else if (arg.compare(0, 12, "--sample-ms=") == 0) {
+        ss.str(arg.substr(12));
+        ss >> options.sample_ms;
+      } else {
+        std::cerr << "Unknown option '" << arg << "'\n";
+        return 1;
+      }
+
+      if (ss.fail() || ss.get() != -1) {
+        std::cerr << "Failed to parse '" << arg << "'\n";
+        return 1;
+      }
+
+      ss.clear();
+    }
+  }
+
+  Benchmark benchmark;
+  addMathBenchmarks(benchmark);
+
+  std::vector<Benchmark::Result> results = benchmark.run(options);
+  Benchmark::writeTable(std::cerr, results);
+
+  if (outPath.empty()) {
+    Benchmark::writeJson(std::cout, options, results);
+  } else {
+    std::ofstream out{outPath};
+    if (!out) {
+      std::cerr << "Failed to open '" << outPath << "'\n";
+      return 1;
+    }
+    Benchmark::writeJson(out, options, results);
+  }
+
+  return 0;
+}
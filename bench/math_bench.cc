@@ -0,0 +1,250 @@
+#include "benchmark.h"
+#include "color.h"
+#include "random.h"
+#include "transform.h"
+#include "math/vector3.h"
+#include "math/vector4.h"
+#include "math/quaternion.h"
+#include "math/matrix4.h"
+#include "math/affine3.h"
+#include "math/bounds.h"
+#include "math/batch.h"
+
+namespace bellum {
+
+namespace {
+
+// Every case walks arrays of this many random inputs, large enough to defeat constant folding and
+// small enough to stay in L1
+constexpr size_t kCount = 256;
+
+struct MathData {
+  std::vector<Vector3> vectors;
+  std::vector<Vector3> other_vectors;
+  std::vector<Quaternion> quaternions;
+  std::vector<Quaternion> other_quaternions;
+  // not unit length
+  std::vector<Quaternion> scaled_quaternions;
+  std::vector<Matrix4> matrices;
+  std::vector<Affine3> affines;
+  std::vector<Bounds> bounds;
+  std::vector<Color> colors;
+  std::vector<float> factors;
+
+  std::vector<Vector3> vector_out;
+  std::vector<Vector4> vector4_out;
+  std::vector<Quaternion> quaternion_out;
+  std::vector<Matrix4> matrix_out;
+  std::vector<Affine3> affine_out;
+  std::vector<float> float_out;
+};
+
+std::shared_ptr<MathData> makeData(uint64 seed) {
+  RandomGenerator random{seed};
+  auto d = std::make_shared<MathData>();
+
+  d->vectors.resize(kCount);
+  d->other_vectors.resize(kCount);
+  random.fill(d->vectors.data(), kCount);
+  random.fill(d->other_vectors.data(), kCount);
+
+  for (size_t i = 0; i < kCount; i++) {
+    Vector3 euler{random.range(-180.0f, 180.0f), random.range(-180.0f, 180.0f),
+                  random.range(-180.0f, 180.0f)};
+    d->quaternions.push_back(Quaternion::makeEuler(euler));
+    d->other_quaternions.push_back(Quaternion::makeEuler(-euler * 0.5f));
+
+    const Quaternion& q = d->quaternions[i];
+    float length = random.range(0.5f, 4.0f);
+    d->scaled_quaternions.push_back({q.x * length, q.y * length, q.z * length, q.w * length});
+
+    Vector3 scale{random.range(0.5f, 2.0f), random.range(0.5f, 2.0f), random.range(0.5f, 2.0f)};
+    d->matrices.push_back(Matrix4::makeTransformation(d->vectors[i], d->quaternions[i], scale));
+    d->affines.push_back(Affine3::makeTransformation(d->vectors[i], d->quaternions[i], scale));
+
+    d->bounds.push_back({d->vectors[i] * 10.0f, scale});
+    d->factors.push_back(random.value());
+  }
+
+  d->colors.resize(kCount);
+  random.fill(d->colors.data(), kCount);
+
+  d->vector_out.resize(kCount);
+  d->vector4_out.resize(kCount);
+  d->quaternion_out.resize(kCount);
+  d->matrix_out.resize(kCount);
+  d->affine_out.resize(kCount);
+  d->float_out.resize(kCount);
+  return d;
+}
+
+// A chain of 'depth' transforms, the last one is the leaf
+std::shared_ptr<std::vector<Transform>> makeHierarchy(uint32 depth, const MathData& d) {
+  auto chain = std::make_shared<std::vector<Transform>>(depth);
+  for (uint32 i = 0; i < depth; i++) {
+    Transform& t = (*chain)[i];
+    t.setLocalPosition(d.vectors[i % kCount]);
+    t.setLocalRotation(d.quaternions[i % kCount]);
+    t.setLocalScale(Vector3::one() + d.other_vectors[i % kCount] * 0.1f);
+    if (i > 0) {
+      t.setParent(&(*chain)[i - 1]);
+    }
+  }
+  return chain;
+}
+
+}
+
+void addMathBenchmarks(Benchmark& benchmark) {
+  auto d = makeData(0x62656E6368ull);
+
+  // Matrix4 and Affine3
+  benchmark.add("matrix4.multiply", kCount, [d] {
+    for (size_t i = 0; i < kCount; i++) {
+      d->matrix_out[i] = d->matrices[i] * d->matrices[(i + 1) % kCount];
+    }
+    Benchmark::keep(d->matrix_out);
+  });
+  benchmark.add("matrix4.inverse", kCount, [d] {
+    for (size_t i = 0; i < kCount; i++) {
+      d->matrix_out[i] = d->matrices[i].inversed();
+    }
+    Benchmark::keep(d->matrix_out);
+  });
+  benchmark.add("matrix4.multiply_point", kCount, [d] {
+    for (size_t i = 0; i < kCount; i++) {
+      d->vector_out[i] = Matrix4::multiplyPoint(d->matrices[i], d->vectors[i]);
+    }
+    Benchmark::keep(d->vector_out);
+  });
+  benchmark.add("affine3.multiply", kCount, [d] {
+    for (size_t i = 0; i < kCount; i++) {
+      d->affine_out[i] = d->affines[i] * d->affines[(i + 1) % kCount];
+    }
+    Benchmark::keep(d->affine_out);
+  });
+  benchmark.add("affine3.inverse", kCount, [d] {
+    for (size_t i = 0; i < kCount; i++) {
+      d->affine_out[i] = d->affines[i].inversed();
+    }
+    Benchmark::keep(d->affine_out);
+  });
+  benchmark.add("affine3.inverse_scaled", kCount, [d] {
+    for (size_t i = 0; i < kCount; i++) {
+      d->affine_out[i] = d->affines[i].inversedScaled();
+    }
+    Benchmark::keep(d->affine_out);
+  });
+
+  // Quaternion
+  benchmark.add("quaternion.multiply", kCount, [d] {
+    for (size_t i = 0; i < kCount; i++) {
+      d->quaternion_out[i] = d->quaternions[i] * d->other_quaternions[i];
+    }
+    Benchmark::keep(d->quaternion_out);
+  });
+  benchmark.add("quaternion.slerp", kCount, [d] {
+    for (size_t i = 0; i < kCount; i++) {
+      d->quaternion_out[i] = Quaternion::slerp(d->quaternions[i], d->other_quaternions[i],
+                                               d->factors[i]);
+    }
+    Benchmark::keep(d->quaternion_out);
+  });
+  benchmark.add("quaternion.normalize", kCount, [d] {
+    for (size_t i = 0; i < kCount; i++) {
+      d->quaternion_out[i] = d->scaled_quaternions[i].normalized();
+    }
+    Benchmark::keep(d->quaternion_out);
+  });
+  benchmark.add("quaternion.normalize_fast", kCount, [d] {
+    for (size_t i = 0; i < kCount; i++) {
+      d->quaternion_out[i] = d->scaled_quaternions[i].normalized<Precision::FAST>();
+    }
+    Benchmark::keep(d->quaternion_out);
+  });
+  benchmark.add("quaternion.rotate", kCount, [d] {
+    for (size_t i = 0; i < kCount; i++) {
+      d->vector_out[i] = d->quaternions[i] * d->vectors[i];
+    }
+    Benchmark::keep(d->vector_out);
+  });
+
+  // Vector3
+  benchmark.add("vector3.add", kCount, [d] {
+    for (size_t i = 0; i < kCount; i++) {
+      d->vector_out[i] = d->vectors[i] + d->other_vectors[i];
+    }
+    Benchmark::keep(d->vector_out);
+  });
+  benchmark.add("vector3.dot", kCount, [d] {
+    for (size_t i = 0; i < kCount; i++) {
+      d->float_out[i] = Vector3::dot(d->vectors[i], d->other_vectors[i]);
+    }
+    Benchmark::keep(d->float_out);
+  });
+  benchmark.add("vector3.cross", kCount, [d] {
+    for (size_t i = 0; i < kCount; i++) {
+      d->vector_out[i] = Vector3::cross(d->vectors[i], d->other_vectors[i]);
+    }
+    Benchmark::keep(d->vector_out);
+  });
+  benchmark.add("vector3.lerp", kCount, [d] {
+    for (size_t i = 0; i < kCount; i++) {
+      d->vector_out[i] = Vector3::lerp(d->vectors[i], d->other_vectors[i], d->factors[i]);
+    }
+    Benchmark::keep(d->vector_out);
+  });
+  benchmark.add("vector3.normalize", kCount, [d] {
+    for (size_t i = 0; i < kCount; i++) {
+      d->vector_out[i] = d->vectors[i].normalized();
+    }
+    Benchmark::keep(d->vector_out);
+  });
+  benchmark.add("vector3.normalize_fast", kCount, [d] {
+    for (size_t i = 0; i < kCount; i++) {
+      d->vector_out[i] = d->vectors[i].normalized<Precision::FAST>();
+    }
+    Benchmark::keep(d->vector_out);
+  });
+
+  // Batch kernels, comparable to the per-element cases above
+  benchmark.add("batch.transform_points", kCount, [d] {
+    Batch::transformPoints(d->matrices[0], d->vectors.data(), d->vector_out.data(), kCount);
+    Benchmark::keep(d->vector_out);
+  });
+  benchmark.add("batch.cross", kCount, [d] {
+    Batch::cross(d->vectors.data(), d->other_vectors.data(), d->vector_out.data(), kCount);
+    Benchmark::keep(d->vector_out);
+  });
+  benchmark.add("batch.normalize", kCount, [d] {
+    std::copy(d->vectors.begin(), d->vectors.end(), d->vector_out.begin());
+    Batch::normalize(d->vector_out.data(), kCount);
+    Benchmark::keep(d->vector_out);
+  });
+
+  // Bounds and Color
+  benchmark.add("bounds.overlaps", kCount, [d] {
+    uint32 overlaps = 0;
+    for (size_t i = 0; i < kCount; i++) {
+      overlaps += d->bounds[i].overlaps(d->bounds[(i + 1) % kCount]) ? 1 : 0;
+    }
+    Benchmark::keep(overlaps);
+  });
+  benchmark.add("color.get_hsv", kCount, [d] {
+    for (size_t i = 0; i < kCount; i++) {
+      Color::getHsv(d->colors[i], d->vector4_out[i]);
+    }
+    Benchmark::keep(d->vector4_out);
+  });
+
+  // Transform, localToWorld walks up the whole chain on every call
+  for (uint32 depth : {1, 4, 16, 64}) {
+    auto chain = makeHierarchy(depth, *d);
+    benchmark.add("transform.local_to_world.depth_" + std::to_string(depth), 1, [chain] {
+      Affine3 m = chain->back().localToWorld();
+      Benchmark::keep(m);
+    });
+  }
+}
+
+}
@@ -0,0 +1,206 @@
+#include <fstream>
+#include <iostream>
+#include "node.h"
+#include "scene.h"
+#include "random.h"
+#include "timing.h"
+#include "components/camera.h"
+#include "components/mesh_filter.h"
+#include "components/mesh_renderer.h"
+#include "headless/headless_application.h"
+#include "profiling/frame_stats.h"
+#include "render/render_stats.h"
+
+using namespace bellum;
+
+namespace {
+
+struct SceneOptions {
+  uint32 nodes = 10000;
+  // Length of every parent to child chain, 1 makes a flat scene
+  uint32 depth = 1;
+  // Share of nodes with a MeshRenderer, and with a Spinner
+  float renderers = 0.5f;
+  float updaters = 0.5f;
+};
+
+// Stands in for gameplay code, touches its transform on every update
+class Spinner : public Component {
+public:
+  void update() override {
+    node_->transform().rotate(0.0f, speed_ * Time::deltaTime(), 0.0f);
+    node_->transform().translate(0.0f, 0.0f, 0.01f * Time::deltaTime());
+  }
+
+  void setSpeed(float speed) {
+    speed_ = speed;
+  }
+
+private:
+  float speed_ = 90.0f;
+};
+
+// Chains of 'depth' nodes below the root until there are 'nodes' of them. Renderers have no mesh,
+// headless rendering never reaches it.
+class StressScene : public Scene {
+public:
+  explicit StressScene(const SceneOptions& options)
+    : options_(options) {}
+
+  void make() override {
+    Node* cameraNode = Node::make();
+    cameraNode->transform().setLocalPosition({0.0f, 0.0f, -50.0f});
+    Camera* camera = cameraNode->addComponent<Camera>();
+    camera->setProjection(Matrix4::makePerspective(Math::rad(60.0f), 16.0f / 9.0f, 0.01f, 500.0f));
+    Camera::setCurrent(camera);
+
+    RandomGenerator& random = Random::generator();
+    Node* parent = nullptr;
+    for (uint32 i = 0; i < options_.nodes; i++) {
+      if (i % options_.depth == 0) {
+        parent = nullptr;
+      }
+
+      Node* node = Node::make(parent);
+      Transform& t = node->transform();
+      if (parent == nullptr) {
+        t.setLocalPosition({random.range(-50.0f, 50.0f), random.range(-50.0f, 50.0f),
+                            random.range(0.0f, 100.0f)});
+      } else {
+        t.setParent(&parent->transform());
+        t.setLocalPosition({random.range(-1.0f, 1.0f), 1.0f, random.range(-1.0f, 1.0f)});
+      }
+      t.setLocalRotation(Quaternion::makeEuler(0.0f, random.range(0.0f, 360.0f), 0.0f));
+
+      if (random.value() < options_.updaters) {
+        node->addComponent<Spinner>()->setSpeed(random.range(-180.0f, 180.0f));
+      }
+      if (random.value() < options_.renderers) {
+        node->addComponent<MeshFilter>();
+        node->addComponent<MeshRenderer>();
+      }
+
+      parent = node;
+    }
+  }
+
+private:
+  SceneOptions options_;
+};
+
+void writeSummary(std::ostream& out, const char* name, FrameStats::Metric metric) {
+  FrameStats::Summary s = FrameStats::summary(metric);
+  out << "    \"" << name << "\": {"
+      << "\"p50\": " << s.p50 << ", "
+      << "\"p95\": " << s.p95 << ", "
+      << "\"p99\": " << s.p99 << ", "
+      << "\"max\": " << s.max << "}";
+}
+
+void writeReport(std::ostream& out, const SceneOptions& options, const HeadlessApplication& app) {
+  out << "{\n  \"scene\": {"
+      << "\"nodes\": " << options.nodes << ", "
+      << "\"depth\": " << options.depth << ", "
+      << "\"renderers\": " << options.renderers << ", "
+      << "\"updaters\": " << options.updaters << "},\n"
+      << "  \"frames\": " << app.frames() << ",\n"
+      << "  \"startup_ms\": " << app.startupMilliseconds() << ",\n"
+      << "  \"phases_ms\": {\n";
+  writeSummary(out, "update", FrameStats::Metric::UPDATE);
+  out << ",\n";
+  writeSummary(out, "render", FrameStats::Metric::RENDER);
+  out << ",\n";
+  writeSummary(out, "frame", FrameStats::Metric::FRAME);
+  out << "\n  },\n  \"render\": {";
+
+  const RenderStats::Counters& counters = RenderStats::last();
+  for (uint8 c = 0; c < static_cast<uint8>(RenderStats::Counter::COUNT); c++) {
+    auto counter = static_cast<RenderStats::Counter>(c);
+    out << (c == 0 ? "" : ", ") << '"' << RenderStats::counterName(counter) << "\": "
+        << counters[counter];
+  }
+
+  out << "},\n  \"memory\": {";
+  for (uint8 t = 0; t < static_cast<uint8>(MemoryTracker::Tag::COUNT); t++) {
+    auto tag = static_cast<MemoryTracker::Tag>(t);
+    MemoryTracker::Stats s = MemoryTracker::stats(tag);
+    out << (t == 0 ? "\n" : ",\n");
+    out << "    \"" << MemoryTracker::tagName(tag) << "\": {"
+        << "\"live_bytes\": " << s.live_bytes << ", "
+        << "\"peak_bytes\": " << s.peak_bytes << ", "
+        << "\"allocations\": " << s.allocations << ", "
+        << "\"frame_allocations\": " << s.frame_allocations << ", "
+        << "\"frame_bytes\": " << s.frame_bytes << "}";
+  }
+  out << "\n  }\n}\n";
+}
+
+}
+
+// Builds a synthetic scene and runs it headless, then writes a JSON report to stdout or to the
+// file given with '--out='. Scene options are '--nodes=', '--depth=', '--renderers=' and
+// '--updaters=', everything else is passed on to HeadlessApplication.
+int main(int argc, char** argv) {
+  SceneOptions options;
+  std::string outPath;
+  std::vector<std::string> forwarded;
+  {
+    // parse '--x=y' arguments
+    std::stringstream ss;
+
+    for (int32 i = 1; i < argc; i++) {
+      std::string arg = argv[i];
+      if (arg.compare(0, 8, "--nodes=") == 0) {
+        ss.str(arg.substr(8));
+        ss >> options.nodes;
+      } else if (arg.compare(0, 8, "--depth=") == 0) {
+        ss.str(arg.substr(8));
+        ss >> options.depth;
+      } else if (arg.compare(0, 12, "--renderers=") == 0) {
+        ss.str(arg.substr(12));
+        ss >> options.renderers;
+      } else if (arg.compare(0, 11, "--updaters=") == 0) {
+        ss.str(arg.substr(11));
+        ss >> options.updaters;
+      } else if (arg.compare(0, 6, "--out=") == 0) {
+        outPath = arg.substr(6);
+        continue;
+      } else {
+        forwarded.push_back(arg);
+        continue;
+      }
+
+      if (ss.fail() || ss.get() != -1) {
+        std::cerr << "Failed to parse '" << arg << "'\n";
+        return 1;
+      }
+
+      ss.clear();
+    }
+  }
+
+  if (options.depth == 0) {
+    std::cerr << "'--depth' must be at least 1\n";
+    return 1;
+  }
+
+  auto app = static_cast<HeadlessApplication*>(Application::instance());
+  app->addScene("Stress", std::make_unique<StressScene>(options));
+  app->start(forwarded);
+  if (!app->succeeded()) {
+    return 1;
+  }
+
+  if (outPath.empty()) {
+    writeReport(std::cout, options, *app);
+  } else {
+    std::ofstream out{outPath};
+    if (!out) {
+      std::cerr << "Failed to open '" << outPath << "'\n";
+      return 1;
+    }
+    writeReport(out, options, *app);
+  }
+
+  return 0;
+}
@@ -1,7 +1,15 @@
 #include "application.h"
+#if defined(BELLUM_HEADLESS)
+#include "headless/headless_application.h"
+#elif defined(BELLUM_STANDALONE)
 #include "standalone/standalone_application.h"
+#endif
+#include "node.h"
 #include "scene_manager.h"
 #include "scene.h"
+#include "components/camera.h"
+#include "profiling/frame_stats.h"
+#include "profiling/profiler.h"
 
 namespace bellum {
 
@@ -10,7 +18,10 @@ Application::Application()
     render_module_(std::make_unique<RenderModule>()) {}
 
 Application* Application::instance() {
-#ifdef BELLUM_STANDALONE
+#if defined(BELLUM_HEADLESS)
+  static HeadlessApplication instance{};
+  return &instance;
+#elif defined(BELLUM_STANDALONE)
   static StandaloneApplication instance{};
   return &instance;
 #endif
@@ -29,14 +40,64 @@ void Application::onStart() {
   currentScene->make();
 }
 
+void Application::onExit() {
+  update_module_->onExit();
+  render_module_->onExit();
+}
+
 void Application::update() {
   update_module_->update();
   render_module_->update();
 }
 
+void Application::latch() {
+  Camera* camera = Camera::current();
+  if (camera == nullptr) {
+    return;
+  }
+
+  for (auto& component : camera->node()->components()) {
+    if (component->enabled()) {
+      component->latch();
+    }
+  }
+}
+
 void Application::render() {
   update_module_->render();
   render_module_->render();
+
+  // frame temporaries of this update and render cycle are dead now
+  FrameAllocator::reset();
+  MemoryTracker::endFrame();
+}
+
+void Application::writeReports(const std::string& statsPath, const std::string& memoryPath,
+                               const std::string& tracePath) {
+  if (!memoryPath.empty()) {
+    if (MemoryTracker::dump(memoryPath)) {
+      logger_->info("Memory statistics written to '", memoryPath, "'");
+    } else {
+      logger_->error("Failed to write memory statistics to '", memoryPath, "'");
+    }
+  }
+
+  if (!statsPath.empty()) {
+    if (FrameStats::dump(statsPath)) {
+      logger_->info("Frame statistics written to '", statsPath, "'");
+    } else {
+      logger_->error("Failed to write frame statistics to '", statsPath, "'");
+    }
+  }
+
+  if (!tracePath.empty()) {
+    Profiler::setEnabled(false);
+    if (Profiler::exportChromeTrace(tracePath)) {
+      logger_->info("Trace written to '", tracePath, "'");
+    } else {
+      logger_->error("Failed to write trace to '", tracePath, "'");
+    }
+  }
 }
 
 }
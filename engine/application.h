@@ -17,6 +17,10 @@ class Application {
 public:
   Application();
 
+  RenderModule* renderModule() {
+    return render_module_.get();
+  }
+
   virtual void start(std::vector<std::string> args) = 0;
   virtual void exit() = 0;
 
@@ -29,8 +33,16 @@ public:
   static Application* instance();
 protected:
   void onStart();
+  void onExit();
   void update();
+  // Lets the components on the current camera's node pick up input that came in after the last
+  // update, call right before render
+  void latch();
   void render();
+  // Writes the end-of-run reports whose path is not empty, the memory statistics have to be
+  // written before resources are disposed
+  void writeReports(const std::string& statsPath, const std::string& memoryPath,
+                    const std::string& tracePath);
 
   std::unique_ptr<Logger> logger_;
   bool running_;
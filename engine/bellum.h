@@ -38,5 +38,6 @@
 #include "math/vector4.h"
 #include "math/quaternion.h"
 #include "math/matrix4.h"
+#include "math/affine3.h"
 
 #endif
@@ -4,7 +4,7 @@
 namespace bellum {
 
 void Color::getHsv(const Color& c, Vector4& dst) {
-  dst.set(0.0f, 0.0f, 0.0f, c.a);
+  dst = {0.0f, 0.0f, 0.0f, c.a};
 
   float r = c.r;
   float g = c.g;
@@ -16,12 +16,9 @@ struct Color {
   float b;
   float a;
 
-  inline Color(float r = 0.0f, float g = 0.0f, float b = 0.0f, float a = 1.0f);
-  inline Color(uint32 rgba);
-  inline Color(const float* data);
-
-  inline Color(const Color& c);
-  inline Color operator=(const Color& c);
+  inline constexpr Color(float r = 0.0f, float g = 0.0f, float b = 0.0f, float a = 1.0f);
+  inline constexpr Color(uint32 rgba);
+  inline constexpr Color(const float* data);
 
   inline void set(float r = 0.0f, float g = 0.0f, float b = 0.0f, float a = 1.0f);
   inline void set(uint32 rgba);
@@ -41,46 +38,37 @@ struct Color {
   inline static void makeHex(const std::string& value, Color& dst);
   inline static void lerp(const Color& a, const Color& b, float t, Color& dst);
 
-  inline static Color& clear();
-  inline static Color& white();
-  inline static Color& lightGray();
-  inline static Color& gray();
-  inline static Color& darkGray();
-  inline static Color& black();
-  inline static Color& red();
-  inline static Color& pink();
-  inline static Color& orange();
-  inline static Color& yellow();
-  inline static Color& green();
-  inline static Color& magenta();
-  inline static Color& cyan();
-  inline static Color& blue();
+  inline static constexpr Color clear();
+  inline static constexpr Color white();
+  inline static constexpr Color lightGray();
+  inline static constexpr Color gray();
+  inline static constexpr Color darkGray();
+  inline static constexpr Color black();
+  inline static constexpr Color red();
+  inline static constexpr Color pink();
+  inline static constexpr Color orange();
+  inline static constexpr Color yellow();
+  inline static constexpr Color green();
+  inline static constexpr Color magenta();
+  inline static constexpr Color cyan();
+  inline static constexpr Color blue();
 
   inline friend std::ostream& operator<<(std::ostream& os, const Color& color);
 };
 
-inline Color::Color(float r, float g, float b, float a)
+inline constexpr Color::Color(float r, float g, float b, float a)
   : r(r), g(g), b(b), a(a) {}
 
-inline Color::Color(uint32 rgba)
-  : Color(static_cast<uint8>(rgba & 0xFF),
-          static_cast<uint8>((rgba >> 8) & 0xFF),
-          static_cast<uint8>((rgba >> 16) & 0xFF),
-          static_cast<uint8>((rgba >> 24) & 0xFF)) {}
-
-inline Color::Color(const Color& c)
-  : r(c.r), g(c.g), b(c.b), a(c.a) {}
+// same channel order as set(uint32)
+inline constexpr Color::Color(uint32 rgba)
+  : Color((rgba & 0xFF) / 255.0f,
+          ((rgba >> 8) & 0xFF) / 255.0f,
+          ((rgba >> 16) & 0xFF) / 255.0f,
+          ((rgba >> 24) & 0xFF) / 255.0f) {}
 
-inline Color::Color(const float* data)
+inline constexpr Color::Color(const float* data)
   : r(data[0]), g(data[1]), b(data[2]), a(data[3]) {}
 
-inline Color Color::operator=(const Color& c) {
-  r = c.r;
-  g = c.g;
-  b = c.b;
-  a = c.a;
-}
-
 inline void Color::set(float r, float g, float b, float a) {
   this->r = r;
   this->g = g;
@@ -208,75 +196,61 @@ inline void Color::lerp(const Color& a, const Color& b, float t, Color& dst) {
   );
 }
 
-// Singletons
-inline Color& Color::clear() {
-  static Color value{0.0f, 0.0f, 0.0f, 0.0f};
-  return value;
+// Constants
+inline constexpr Color Color::clear() {
+  return Color{0.0f, 0.0f, 0.0f, 0.0f};
 }
 
-inline Color& Color::white() {
-  static Color value{1.0f, 1.0f, 1.0f};
-  return value;
+inline constexpr Color Color::white() {
+  return Color{1.0f, 1.0f, 1.0f};
 }
 
-inline Color& Color::lightGray() {
-  static Color value{192 / 255.0f, 192 / 255.0f, 192 / 255.0f};
-  return value;
+inline constexpr Color Color::lightGray() {
+  return Color{192 / 255.0f, 192 / 255.0f, 192 / 255.0f};
 }
 
-inline Color& Color::gray() {
-  static Color value{128 / 255.0f, 128 / 255.0f, 128 / 255.0f};
-  return value;
+inline constexpr Color Color::gray() {
+  return Color{128 / 255.0f, 128 / 255.0f, 128 / 255.0f};
 }
 
-inline Color& Color::darkGray() {
-  static Color value{64 / 255.0f, 64 / 255.0f, 64 / 255.0f};
-  return value;
+inline constexpr Color Color::darkGray() {
+  return Color{64 / 255.0f, 64 / 255.0f, 64 / 255.0f};
 }
 
-inline Color& Color::black() {
-  static Color value{0, 0, 0};
-  return value;
+inline constexpr Color Color::black() {
+  return Color{0, 0, 0};
 }
 
-inline Color& Color::red() {
-  static Color value{1.0f, 0, 0};
-  return value;
+inline constexpr Color Color::red() {
+  return Color{1.0f, 0, 0};
 }
 
-inline Color& Color::pink() {
-  static Color value{1.0f, 175 / 255.0f, 175 / 255.0f};
-  return value;
+inline constexpr Color Color::pink() {
+  return Color{1.0f, 175 / 255.0f, 175 / 255.0f};
 }
 
-inline Color& Color::orange() {
-  static Color value{1.0f, 200 / 255.0f, 0};
-  return value;
+inline constexpr Color Color::orange() {
+  return Color{1.0f, 200 / 255.0f, 0};
 }
 
-inline Color& Color::yellow() {
-  static Color value{1.0f, 1.0f, 0};
-  return value;
+inline constexpr Color Color::yellow() {
+  return Color{1.0f, 1.0f, 0};
 }
 
-inline Color& Color::green() {
-  static Color value{0, 1.0f, 0};
-  return value;
+inline constexpr Color Color::green() {
+  return Color{0, 1.0f, 0};
 }
 
-inline Color& Color::magenta() {
-  static Color value{1.0f, 0, 1.0f};
-  return value;
+inline constexpr Color Color::magenta() {
+  return Color{1.0f, 0, 1.0f};
 }
 
-inline Color& Color::cyan() {
-  static Color value{0, 1.0f, 1.0f};
-  return value;
+inline constexpr Color Color::cyan() {
+  return Color{0, 1.0f, 1.0f};
 }
 
-inline Color& Color::blue() {
-  static Color value{0, 0, 1.0f};
-  return value;
+inline constexpr Color Color::blue() {
+  return Color{0, 0, 1.0f};
 }
 
 inline std::ostream& operator<<(std::ostream& os, const Color& c) {
@@ -284,6 +258,10 @@ inline std::ostream& operator<<(std::ostream& os, const Color& c) {
   return os;
 }
 
+inline void formatValue(FormatBuffer& out, const Color& c) {
+  out << "Color(r: " << c.r << ", g: " << c.g << ", b: " << c.b << ", a: " << c.a << ')';
+}
+
 }
 
 #endif
@@ -9,7 +9,9 @@
 #include <functional>
 
 #include "common/formatter.h"
+#include "common/frame_allocator.h"
 #include "common/macros.h"
+#include "common/memory_tracker.h"
 #include "common/os.h"
 #include "common/types.h"
 #include "common/logger.h"
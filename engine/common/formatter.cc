@@ -0,0 +1,125 @@
+#include "formatter.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace bellum {
+
+FormatBuffer& FormatBuffer::append(const char* str, size_t length) {
+  if (capacity_ == 0) {
+    truncated_ = truncated_ || length > 0;
+    return *this;
+  }
+
+  size_t available = capacity_ - 1 - size_;
+  if (length > available) {
+    length = available;
+    truncated_ = true;
+  }
+
+  std::memcpy(data_ + size_, str, length);
+  size_ += length;
+  data_[size_] = '\0';
+  return *this;
+}
+
+FormatBuffer& FormatBuffer::append(char c) {
+  return append(&c, 1);
+}
+
+FormatBuffer& FormatBuffer::appendSigned(int64 value) {
+  if (value < 0) {
+    append('-');
+    // negate in unsigned space so the minimum value doesn't overflow
+    return appendUnsigned(0 - static_cast<uint64>(value));
+  }
+  return appendUnsigned(static_cast<uint64>(value));
+}
+
+FormatBuffer& FormatBuffer::appendUnsigned(uint64 value) {
+  char digits[20];
+  size_t count = 0;
+  do {
+    digits[sizeof(digits) - 1 - count++] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+
+  return append(digits + sizeof(digits) - count, count);
+}
+
+FormatBuffer& FormatBuffer::appendFloat(double value) {
+  // same as the default ostream formatting
+  char digits[32];
+  int32 length = std::snprintf(digits, sizeof(digits), "%g", value);
+  return append(digits, static_cast<size_t>(std::max(length, 0)));
+}
+
+FormatBuffer& FormatBuffer::appendPointer(const void* pointer) {
+  char digits[2 + 2 * sizeof(void*) + 1];
+  int32 length = std::snprintf(digits, sizeof(digits), "%p", pointer);
+  return append(digits, static_cast<size_t>(std::max(length, 0)));
+}
+
+void FormatRecordWriter::add(const char* str, size_t length) {
+  static constexpr size_t kHeaderSize = 1 + sizeof(uint16);
+  if (truncated_ || size_ + kHeaderSize >= capacity_) {
+    truncated_ = true;
+    return;
+  }
+
+  // keep as much of a long string as fits
+  size_t available = std::min<size_t>(capacity_ - size_ - kHeaderSize, UINT16_MAX);
+  if (length > available) {
+    length = available;
+    truncated_ = true;
+  }
+  uint16 stored = static_cast<uint16>(length);
+
+  data_[size_++] = kString;
+  std::memcpy(data_ + size_, &stored, sizeof(stored));
+  size_ += sizeof(stored);
+  std::memcpy(data_ + size_, str, length);
+  size_ += length;
+}
+
+void FormatRecordWriter::addValue(FormatFunction format, const void* value, uint16 size) {
+  if (truncated_ || size_ + 1 + sizeof(format) + sizeof(size) + size > capacity_) {
+    truncated_ = true;
+    return;
+  }
+
+  data_[size_++] = kValue;
+  std::memcpy(data_ + size_, &format, sizeof(format));
+  size_ += sizeof(format);
+  std::memcpy(data_ + size_, &size, sizeof(size));
+  size_ += sizeof(size);
+  std::memcpy(data_ + size_, value, size);
+  size_ += size;
+}
+
+bool FormatRecordReader::next(FormatBuffer& out) {
+  if (position_ >= size_) {
+    return false;
+  }
+
+  uint8 tag = data_[position_++];
+  if (tag == FormatRecordWriter::kString) {
+    uint16 length;
+    std::memcpy(&length, data_ + position_, sizeof(length));
+    position_ += sizeof(length);
+    out.append(reinterpret_cast<const char*>(data_ + position_), length);
+    position_ += length;
+  } else {
+    FormatRecordWriter::FormatFunction format;
+    std::memcpy(&format, data_ + position_, sizeof(format));
+    position_ += sizeof(format);
+    uint16 size;
+    std::memcpy(&size, data_ + position_, sizeof(size));
+    position_ += sizeof(size);
+    format(out, data_ + position_);
+    position_ += size;
+  }
+
+  return true;
+}
+
+}
@@ -1,32 +1,293 @@
 #ifndef __BELLUM_FMT_H__
 #define __BELLUM_FMT_H__
 
-#include <string>
+#include <cstring>
 #include <sstream>
+#include <string>
+#include <type_traits>
+#include "types.h"
 
 namespace bellum {
 
-class Formatter {
+// Appends text to a fixed caller-provided buffer, output that doesn't fit is cut off. The
+// contents are always null-terminated, a capacity of 0 never touches 'data' and truncates
+// everything.
+class FormatBuffer {
+public:
+  FormatBuffer(char* data, size_t capacity)
+    : data_(data), capacity_(capacity), size_(0), truncated_(false) {
+    if (capacity_ > 0) {
+      data_[0] = '\0';
+    }
+  }
+
+  template<size_t N>
+  explicit FormatBuffer(char (& data)[N])
+    : FormatBuffer(data, N) {}
+
+  FormatBuffer& append(const char* str, size_t length);
+  FormatBuffer& append(char c);
+  FormatBuffer& appendSigned(int64 value);
+  FormatBuffer& appendUnsigned(uint64 value);
+  FormatBuffer& appendFloat(double value);
+  FormatBuffer& appendPointer(const void* pointer);
+
+  inline FormatBuffer& append(const char* str) {
+    return append(str, std::strlen(str));
+  }
+
+  template<typename T>
+  inline FormatBuffer& operator<<(const T& value);
+
+  inline void clear() {
+    size_ = 0;
+    truncated_ = false;
+    if (capacity_ > 0) {
+      data_[0] = '\0';
+    }
+  }
+
+  inline const char* c_str() const {
+    return capacity_ > 0 ? data_ : "";
+  }
+
+  inline size_t size() const {
+    return size_;
+  }
+
+  inline bool truncated() const {
+    return truncated_;
+  }
+
+  inline std::string str() const {
+    return std::string{data_, size_};
+  }
+
+private:
+  char* data_;
+  size_t capacity_;
+  size_t size_;
+  bool truncated_;
+};
+
+// formatValue overloads define how a type is written to a FormatBuffer, types declare their own
+// next to their definition.
+
+inline void formatValue(FormatBuffer& out, const char* str) {
+  out.append(str);
+}
+
+inline void formatValue(FormatBuffer& out, const std::string& str) {
+  out.append(str.data(), str.size());
+}
+
+inline void formatValue(FormatBuffer& out, char c) {
+  out.append(c);
+}
+
+inline void formatValue(FormatBuffer& out, bool value) {
+  out.append(value ? "1" : "0");
+}
+
+inline void formatValue(FormatBuffer& out, const void* pointer) {
+  out.appendPointer(pointer);
+}
+
+template<typename T>
+inline std::enable_if_t<std::is_integral<T>::value && std::is_signed<T>::value>
+formatValue(FormatBuffer& out, T value) {
+  out.appendSigned(value);
+}
+
+template<typename T>
+inline std::enable_if_t<std::is_integral<T>::value && std::is_unsigned<T>::value>
+formatValue(FormatBuffer& out, T value) {
+  out.appendUnsigned(value);
+}
+
+template<typename T>
+inline std::enable_if_t<std::is_floating_point<T>::value>
+formatValue(FormatBuffer& out, T value) {
+  out.appendFloat(value);
+}
+
+// Anything else goes through its operator<<, which allocates
+template<typename T>
+inline std::enable_if_t<!std::is_arithmetic<T>::value && !std::is_pointer<T>::value>
+formatValue(FormatBuffer& out, const T& value) {
+  std::ostringstream ss;
+  ss << value;
+  std::string str = ss.str();
+  out.append(str.data(), str.size());
+}
+
+template<typename T>
+inline FormatBuffer& FormatBuffer::operator<<(const T& value) {
+  formatValue(*this, value);
+  return *this;
+}
+
+// Records format arguments in binary so they can be formatted later, possibly on another thread.
+// Strings are copied, trivially copyable values are stored as raw bytes together with their
+// formatValue, anything else is formatted right away.
+class FormatRecordWriter {
 public:
+  FormatRecordWriter(uint8* data, size_t capacity)
+    : data_(data), capacity_(capacity), size_(0), truncated_(false) {}
+
+  void add(const char* str, size_t length);
+
+  inline void add(const char* str) {
+    add(str, std::strlen(str));
+  }
+
+  inline void add(const std::string& str) {
+    add(str.data(), str.size());
+  }
+
+  inline void add(const void* pointer) {
+    addValue(&formatStored<const void*>, &pointer, static_cast<uint16>(sizeof(pointer)));
+  }
+
+  template<typename T>
+  inline std::enable_if_t<std::is_trivially_copyable<T>::value && !std::is_pointer<T>::value>
+  add(const T& value);
+
+  template<typename T>
+  inline std::enable_if_t<!std::is_trivially_copyable<T>::value> add(const T& value);
+
+  inline void addAll() {}
+
   template<typename T, typename ...Args>
-  static std::string str(T&& msg, Args&& ... args) {
-    std::stringstream ss;
-    fmtHelper(ss, msg, std::forward<Args>(args)...);
-    return ss.str();
+  inline void addAll(T&& value, Args&& ... args) {
+    add(value);
+    addAll(std::forward<Args>(args)...);
+  }
+
+  inline size_t size() const {
+    return size_;
+  }
+
+  // An argument didn't fit, it and everything after it were left out
+  inline bool truncated() const {
+    return truncated_;
   }
 
 private:
-  static void fmtHelper(std::stringstream& ss) {
-    ss << std::endl;
+  using FormatFunction = void (*)(FormatBuffer& out, const void* value);
+
+  enum Tag : uint8 {
+    kString,
+    kValue
+  };
+
+  uint8* data_;
+  size_t capacity_;
+  size_t size_;
+  bool truncated_;
+
+  void addValue(FormatFunction format, const void* value, uint16 size);
+
+  template<typename T>
+  static void formatStored(FormatBuffer& out, const void* value) {
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    std::memcpy(&storage, value, sizeof(T));
+    formatValue(out, *reinterpret_cast<const T*>(&storage));
   }
 
+  friend class FormatRecordReader;
+};
+
+class FormatRecordReader {
+public:
+  FormatRecordReader(const uint8* data, size_t size)
+    : data_(data), size_(size), position_(0) {}
+
+  // Formats the next argument, returns false once all were read
+  bool next(FormatBuffer& out);
+
+private:
+  const uint8* data_;
+  size_t size_;
+  size_t position_;
+};
+
+class Formatter {
+public:
+  static constexpr size_t kThreadBufferSize = 1024;
+
+  // Formats into a thread-local buffer, which stays valid until the next call on the same thread
+  template<typename ...Args>
+  static const char* format(Args&& ... args) {
+    FormatBuffer& out = threadBuffer();
+    out.clear();
+    fmtHelper(out, std::forward<Args>(args)...);
+    return out.c_str();
+  }
+
+  // Formats into 'buffer' and returns the length written, excluding the null terminator. Writes
+  // nothing when 'capacity' is 0.
+  template<typename ...Args>
+  static size_t write(char* buffer, size_t capacity, Args&& ... args) {
+    FormatBuffer out{buffer, capacity};
+    fmtHelper(out, std::forward<Args>(args)...);
+    return out.size();
+  }
+
+  // Never truncates, text longer than the thread-local buffer is formatted again on the heap
+  template<typename ...Args>
+  static std::string str(Args&& ... args) {
+    FormatBuffer& out = threadBuffer();
+    out.clear();
+    fmtHelper(out, args...);
+    if (!out.truncated()) {
+      return out.str();
+    }
+
+    std::string result(kThreadBufferSize * 4, '\0');
+    while (true) {
+      FormatBuffer large{&result[0], result.size()};
+      fmtHelper(large, args...);
+      if (!large.truncated()) {
+        result.resize(large.size());
+        return result;
+      }
+      result.resize(result.size() * 2);
+    }
+  }
+
+private:
+  static FormatBuffer& threadBuffer() {
+    static thread_local char data[kThreadBufferSize];
+    static thread_local FormatBuffer buffer{data};
+    return buffer;
+  }
+
+  static void fmtHelper(FormatBuffer& out) {}
+
   template<typename T, typename... Args>
-  static void fmtHelper(std::stringstream& ss, T&& msg, Args&& ...args) {
-    ss << std::forward<T>(msg);
-    fmtHelper(ss, std::forward<Args>(args)...);
+  static void fmtHelper(FormatBuffer& out, T&& msg, Args&& ...args) {
+    out << msg;
+    fmtHelper(out, std::forward<Args>(args)...);
   }
 };
 
+template<typename T>
+inline std::enable_if_t<std::is_trivially_copyable<T>::value && !std::is_pointer<T>::value>
+FormatRecordWriter::add(const T& value) {
+  static_assert(sizeof(T) <= UINT16_MAX, "Value too large to record");
+  addValue(&formatStored<T>, &value, static_cast<uint16>(sizeof(T)));
+}
+
+template<typename T>
+inline std::enable_if_t<!std::is_trivially_copyable<T>::value>
+FormatRecordWriter::add(const T& value) {
+  char data[Formatter::kThreadBufferSize];
+  FormatBuffer out{data};
+  out << value;
+  add(out.c_str(), out.size());
+}
+
 }
 
 #endif
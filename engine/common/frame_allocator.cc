@@ -0,0 +1,86 @@
+#include "frame_allocator.h"
+#include <algorithm>
+
+namespace bellum {
+
+constexpr size_t FrameAllocator::kBlockSize;
+
+FrameAllocator::Arena::~Arena() {
+  for (const auto& block : blocks) {
+    MemoryTracker::freed(MemoryTracker::Tag::FRAME, block.size);
+  }
+}
+
+FrameAllocator::Arena& FrameAllocator::threadArena() {
+  static thread_local Arena arena;
+  return arena;
+}
+
+void* FrameAllocator::allocate(size_t size, size_t alignment) {
+  Arena& arena = threadArena();
+
+  // first block from the current one on with enough room left
+  for (; arena.block < arena.blocks.size(); arena.block++) {
+    Block& block = arena.blocks[arena.block];
+    uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+    size_t aligned = ((base + arena.offset + alignment - 1) & ~(alignment - 1)) - base;
+
+    if (aligned + size <= block.size) {
+      arena.offset = aligned + size;
+      arena.peak = std::max(arena.peak, arena.filled + arena.offset);
+      return block.data.get() + aligned;
+    }
+
+    arena.filled += block.size;
+    arena.offset = 0;
+  }
+
+  // requests larger than a block get a dedicated one, released again on reset
+  size_t blockSize = std::max(kBlockSize, size + alignment);
+  arena.blocks.push_back(Block{std::unique_ptr<uint8[]>(new uint8[blockSize]), blockSize});
+  MemoryTracker::allocated(MemoryTracker::Tag::FRAME, blockSize);
+  return allocate(size, alignment);
+}
+
+FrameAllocator::Marker FrameAllocator::mark() {
+  Arena& arena = threadArena();
+  return Marker{arena.block, arena.offset};
+}
+
+void FrameAllocator::rewind(const Marker& marker) {
+  Arena& arena = threadArena();
+  arena.block = marker.block;
+  arena.offset = marker.offset;
+  arena.filled = 0;
+  for (size_t i = 0; i < marker.block; i++) {
+    arena.filled += arena.blocks[i].size;
+  }
+}
+
+void FrameAllocator::reset() {
+  Arena& arena = threadArena();
+
+  // blocks made for oversized requests don't outlive the frame
+  auto oversized = std::partition(arena.blocks.begin(), arena.blocks.end(), [](const Block& block) {
+    return block.size <= kBlockSize;
+  });
+  for (auto it = oversized; it != arena.blocks.end(); ++it) {
+    MemoryTracker::freed(MemoryTracker::Tag::FRAME, it->size);
+  }
+  arena.blocks.erase(oversized, arena.blocks.end());
+
+  arena.block = 0;
+  arena.offset = 0;
+  arena.filled = 0;
+}
+
+size_t FrameAllocator::bytesUsed() {
+  Arena& arena = threadArena();
+  return arena.filled + arena.offset;
+}
+
+size_t FrameAllocator::peakBytesUsed() {
+  return threadArena().peak;
+}
+
+}
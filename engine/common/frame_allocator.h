@@ -0,0 +1,116 @@
+#ifndef BELLUM_FRAME_ALLOCATOR_H
+#define BELLUM_FRAME_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "macros.h"
+#include "memory_tracker.h"
+#include "types.h"
+
+namespace bellum {
+
+// Bump allocator for temporaries that live at most until the end of the frame. Every thread
+// allocates from its own arena, nothing is freed individually. The application resets the main
+// thread's arena after each update and render cycle, other threads reset their own or rewind
+// with a Scope.
+class FrameAllocator {
+public:
+  static constexpr size_t kBlockSize = 1024 * 1024;
+
+  struct Marker {
+    size_t block;
+    size_t offset;
+  };
+
+  // Rewinds the calling thread's arena to where it was when the scope was entered
+  class Scope {
+  public:
+    Scope()
+      : marker_(FrameAllocator::mark()) {}
+
+    ~Scope() {
+      FrameAllocator::rewind(marker_);
+    }
+
+    DELETE_COPY_AND_ASSIGN(Scope);
+
+  private:
+    Marker marker_;
+  };
+
+  static void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+  // Elements are left uninitialized
+  template<typename T>
+  static inline T* allocateArray(size_t count) {
+    return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+  }
+
+  static Marker mark();
+  static void rewind(const Marker& marker);
+
+  // Releases everything the calling thread allocated since the last reset
+  static void reset();
+
+  // Bytes handed out on the calling thread since the last reset, and the most it ever used
+  static size_t bytesUsed();
+  static size_t peakBytesUsed();
+
+private:
+  struct Block {
+    std::unique_ptr<uint8[]> data;
+    size_t size;
+  };
+
+  struct Arena {
+    std::vector<Block> blocks;
+    size_t block = 0;
+    size_t offset = 0;
+    // sizes of the blocks before the current one, skipped tails count as used
+    size_t filled = 0;
+    size_t peak = 0;
+
+    ~Arena();
+  };
+
+  FrameAllocator() {}
+
+  static Arena& threadArena();
+};
+
+// Lets standard containers allocate from the frame arena, deallocation is a no-op
+template<typename T>
+class FrameStlAllocator {
+public:
+  using value_type = T;
+
+  FrameStlAllocator() {}
+
+  template<typename U>
+  FrameStlAllocator(const FrameStlAllocator<U>& other) {}
+
+  inline T* allocate(size_t count) {
+    return FrameAllocator::allocateArray<T>(count);
+  }
+
+  inline void deallocate(T* pointer, size_t count) {}
+
+  template<typename U>
+  inline bool operator==(const FrameStlAllocator<U>& other) const {
+    return true;
+  }
+
+  template<typename U>
+  inline bool operator!=(const FrameStlAllocator<U>& other) const {
+    return false;
+  }
+};
+
+template<typename T>
+using FrameVector = std::vector<T, FrameStlAllocator<T>>;
+
+}
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef BELLUM_HASH_H
+#define BELLUM_HASH_H
+
+#include <string>
+#include "types.h"
+
+namespace bellum {
+
+// 64 bit FNV-1a, not meant to resist collisions someone crafted on purpose
+class Hash {
+public:
+  static constexpr uint64 kFnvOffset = 14695981039346656037ull;
+  static constexpr uint64 kFnvPrime = 1099511628211ull;
+
+  // Continues 'hash', so data split over several calls hashes like the joined data
+  static inline uint64 fnv1a(const void* data, size_t size, uint64 hash = kFnvOffset) {
+    auto bytes = static_cast<const uint8*>(data);
+    for (size_t i = 0; i < size; i++) {
+      hash ^= bytes[i];
+      hash *= kFnvPrime;
+    }
+    return hash;
+  }
+
+  static inline uint64 fnv1a(const std::string& data, uint64 hash = kFnvOffset) {
+    return fnv1a(data.data(), data.size(), hash);
+  }
+
+private:
+  Hash() {}
+};
+
+}
+
+#endif
@@ -0,0 +1,63 @@
+#include "log_sink.h"
+#include <cstdio>
+#include <iostream>
+
+namespace bellum {
+
+void ConsoleSink::write(LogLevel level, const char* message, size_t length) {
+  std::ostream& out = level >= LogLevel::WARNING ? std::cerr : std::cout;
+  out.write(message, length);
+  out.put('\n');
+}
+
+void ConsoleSink::flush() {
+  std::cout.flush();
+  std::cerr.flush();
+}
+
+RotatingFileSink::RotatingFileSink(const std::string& path, uint64 maxBytes, uint32 maxFiles)
+  : path_(path), max_bytes_(maxBytes), max_files_(maxFiles), written_(0) {
+  file_.open(path_, std::ios::out | std::ios::app);
+  if (file_.is_open()) {
+    file_.seekp(0, std::ios::end);
+    written_ = static_cast<uint64>(file_.tellp());
+  }
+}
+
+void RotatingFileSink::write(LogLevel level, const char* message, size_t length) {
+  if (!file_.is_open()) {
+    return;
+  }
+
+  if (written_ > 0 && written_ + length + 1 > max_bytes_) {
+    rotate();
+  }
+
+  file_.write(message, length);
+  file_.put('\n');
+  written_ += length + 1;
+}
+
+void RotatingFileSink::flush() {
+  file_.flush();
+}
+
+void RotatingFileSink::rotate() {
+  file_.close();
+
+  if (max_files_ == 0) {
+    std::remove(path_.c_str());
+  } else {
+    std::remove((path_ + '.' + std::to_string(max_files_)).c_str());
+    for (uint32 i = max_files_ - 1; i > 0; i--) {
+      std::rename((path_ + '.' + std::to_string(i)).c_str(),
+                  (path_ + '.' + std::to_string(i + 1)).c_str());
+    }
+    std::rename(path_.c_str(), (path_ + ".1").c_str());
+  }
+
+  file_.open(path_, std::ios::out | std::ios::trunc);
+  written_ = 0;
+}
+
+}
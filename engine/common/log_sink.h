@@ -0,0 +1,52 @@
+#ifndef BELLUM_LOG_SINK_H
+#define BELLUM_LOG_SINK_H
+
+#include <fstream>
+#include <string>
+#include "logger.h"
+
+namespace bellum {
+
+// Destination of formatted log lines, only called from the log thread
+class LogSink {
+public:
+  virtual ~LogSink() {}
+
+  virtual void write(LogLevel level, const char* message, size_t length) = 0;
+
+  // Called after every drained batch
+  virtual void flush() {}
+};
+
+// Warnings and errors go to stderr, everything else to stdout
+class ConsoleSink : public LogSink {
+public:
+  void write(LogLevel level, const char* message, size_t length) override;
+  void flush() override;
+};
+
+// Appends to 'path' and shifts it to 'path.1' ... 'path.<maxFiles>' once it grows past maxBytes
+class RotatingFileSink : public LogSink {
+public:
+  RotatingFileSink(const std::string& path, uint64 maxBytes = 8 * 1024 * 1024, uint32 maxFiles = 3);
+
+  void write(LogLevel level, const char* message, size_t length) override;
+  void flush() override;
+
+  inline bool isOpen() const {
+    return file_.is_open();
+  }
+
+private:
+  std::string path_;
+  uint64 max_bytes_;
+  uint32 max_files_;
+  uint64 written_;
+  std::ofstream file_;
+
+  void rotate();
+};
+
+}
+
+#endif
@@ -0,0 +1,190 @@
+#include "logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include "log_sink.h"
+
+namespace bellum {
+
+namespace {
+
+// How long the log thread sleeps when every queue is empty
+constexpr std::chrono::milliseconds kIdleWait{10};
+
+}
+
+LogBackend& LogBackend::instance() {
+  static LogBackend backend;
+  return backend;
+}
+
+LogBackend::LogBackend()
+  : policy_(OverflowPolicy::DROP),
+    dropped_(0),
+    reported_dropped_(0),
+    running_(true),
+    flush_requested_(0),
+    flush_done_(0) {
+  sinks_.push_back(std::make_unique<ConsoleSink>());
+  worker_ = std::thread{&LogBackend::run, this};
+}
+
+LogBackend::~LogBackend() {
+  shutdown();
+}
+
+void LogBackend::addSink(std::unique_ptr<LogSink> sink) {
+  std::lock_guard<std::mutex> lock{sinks_mutex_};
+  sinks_.push_back(std::move(sink));
+}
+
+void LogBackend::clearSinks() {
+  std::lock_guard<std::mutex> lock{sinks_mutex_};
+  sinks_.clear();
+}
+
+LogBackend::ThreadQueue& LogBackend::threadQueue() {
+  // the backend keeps its own reference so messages outlive the thread that logged them
+  static thread_local std::shared_ptr<ThreadQueue> queue;
+
+  if (!queue) {
+    queue = std::shared_ptr<ThreadQueue>{new ThreadQueue};
+    std::lock_guard<std::mutex> lock{queues_mutex_};
+    queues_.push_back(queue);
+  }
+
+  return *queue;
+}
+
+bool LogBackend::waitForSpace() {
+  if (policy_.load(std::memory_order_relaxed) == OverflowPolicy::DROP ||
+      !running_.load(std::memory_order_acquire)) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  wake_.notify_one();
+  std::this_thread::yield();
+  return true;
+}
+
+void LogBackend::flush() {
+  std::unique_lock<std::mutex> lock{wake_mutex_};
+  if (!running_.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  uint64 ticket = ++flush_requested_;
+  wake_.notify_one();
+  flushed_.wait(lock, [this, ticket]() {
+    return flush_done_ >= ticket;
+  });
+}
+
+void LogBackend::shutdown() {
+  {
+    std::lock_guard<std::mutex> lock{wake_mutex_};
+    if (!running_.load(std::memory_order_acquire)) {
+      return;
+    }
+    running_.store(false, std::memory_order_release);
+  }
+
+  wake_.notify_one();
+  worker_.join();
+}
+
+void LogBackend::run() {
+  while (true) {
+    uint64 requested;
+    bool running;
+    {
+      std::lock_guard<std::mutex> lock{wake_mutex_};
+      requested = flush_requested_;
+      running = running_.load(std::memory_order_acquire);
+    }
+
+    bool wrote = drain();
+
+    std::unique_lock<std::mutex> lock{wake_mutex_};
+    flush_done_ = requested;
+    flushed_.notify_all();
+
+    if (!running) {
+      break;
+    }
+
+    if (!wrote) {
+      wake_.wait_for(lock, kIdleWait, [this]() {
+        return flush_requested_ != flush_done_ || !running_.load(std::memory_order_acquire);
+      });
+    }
+  }
+}
+
+bool LogBackend::drain() {
+  bool wrote = false;
+
+  {
+    std::lock_guard<std::mutex> queuesLock{queues_mutex_};
+
+    for (const auto& queue : queues_) {
+      while (queue->entries.tryPop([this](const Entry& entry) {
+        writeEntry(entry);
+      })) {
+        wrote = true;
+      }
+    }
+
+    // forget queues of threads that exited once they are empty
+    queues_.erase(std::remove_if(queues_.begin(), queues_.end(),
+                                 [](const std::shared_ptr<ThreadQueue>& queue) {
+                                   return queue.use_count() == 1 && queue->entries.empty();
+                                 }),
+                  queues_.end());
+  }
+
+  uint64 dropped = dropped_.load(std::memory_order_relaxed);
+  if (dropped != reported_dropped_) {
+    char line[kMaxLineLength];
+    size_t length = Formatter::write(line, sizeof(line), "[Logger]: Dropped ",
+                                     dropped - reported_dropped_, " messages, log queue was full");
+    reported_dropped_ = dropped;
+    writeToSinks(LogLevel::WARNING, line, length);
+    wrote = true;
+  }
+
+  if (wrote) {
+    std::lock_guard<std::mutex> lock{sinks_mutex_};
+    for (const auto& sink : sinks_) {
+      sink->flush();
+    }
+  }
+
+  return wrote;
+}
+
+void LogBackend::writeEntry(const Entry& entry) {
+  char line[kMaxLineLength];
+  FormatBuffer out{line};
+  FormatRecordReader reader{entry.data, entry.size};
+
+  out << '[';
+  reader.next(out);
+  out << "]: ";
+  while (reader.next(out)) {}
+  if (entry.truncated) {
+    out << "...";
+  }
+
+  writeToSinks(entry.level, out.c_str(), out.size());
+}
+
+void LogBackend::writeToSinks(LogLevel level, const char* message, size_t length) {
+  std::lock_guard<std::mutex> lock{sinks_mutex_};
+  for (const auto& sink : sinks_) {
+    sink->write(level, message, length);
+  }
+}
+
+}
@@ -1,11 +1,41 @@
 #ifndef BELLUM_LOGGER_H
 #define BELLUM_LOGGER_H
 
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <string>
-#include <iostream>
+#include <thread>
+#include <vector>
+#include "formatter.h"
+#include "macros.h"
+#include "memory_tracker.h"
+#include "ring_buffer.h"
+#include "types.h"
+
+// Messages below this level are compiled out: 0 debug, 1 info, 2 warning, 3 error
+#ifndef BELLUM_LOG_LEVEL
+#define BELLUM_LOG_LEVEL 0
+#endif
 
 namespace bellum {
 
+class LogSink;
+
+enum class LogLevel : uint8 {
+  DEBUG,
+  INFO,
+  WARNING,
+  ERROR
+};
+
+// What a producer does when its queue is full
+enum class OverflowPolicy : uint8 {
+  DROP,
+  BLOCK
+};
+
 class Logger {
 public:
   Logger() {}
@@ -13,42 +43,145 @@ public:
   Logger(std::string name)
     : name_(name) {}
 
-  template<typename T, typename ...Args>
-  void info(T&& msg, Args&& ... args) {
-    std::cout << '[' << name_ << "]: ";
-    printHelper(std::cout, msg, std::forward<Args>(args)...);
+  template<typename ...Args>
+  void debug(Args&& ... args) {
+    log<LogLevel::DEBUG>(std::forward<Args>(args)...);
   }
 
-  template<typename T>
-  void info(T&& msg) {
-    std::cout << '[' << name_ << "]: " << msg << std::endl;
+  template<typename ...Args>
+  void info(Args&& ... args) {
+    log<LogLevel::INFO>(std::forward<Args>(args)...);
   }
 
-  template<typename T, typename ...Args>
-  void error(T&& msg, Args&& ... args) {
-    std::cerr << '[' << name_ << "]: ";
-    printHelper(std::cerr, msg, std::forward<Args>(args)...);
+  template<typename ...Args>
+  void warning(Args&& ... args) {
+    log<LogLevel::WARNING>(std::forward<Args>(args)...);
   }
 
-  template<typename T>
-  void error(T&& msg) {
-    std::cerr << '[' << name_ << "]: " << msg << std::endl;
+  template<typename ...Args>
+  void error(Args&& ... args) {
+    log<LogLevel::ERROR>(std::forward<Args>(args)...);
   }
 
+  template<LogLevel level, typename ...Args>
+  void log(Args&& ... args);
+
 private:
   std::string name_;
+};
 
-  void printHelper(std::ostream& out) {
-    out << std::endl;
+// Collects messages from every thread into per-thread lock-free queues, a background thread
+// formats them and writes them to the sinks. Only the arguments are recorded on the logging
+// thread, see FormatRecordWriter.
+class LogBackend {
+public:
+  static constexpr uint32 kQueueCapacity = 1024;
+  static constexpr uint32 kMaxRecordSize = 244;
+  static constexpr uint32 kMaxLineLength = 1024;
+
+  static LogBackend& instance();
+
+  ~LogBackend();
+
+  DELETE_COPY_AND_ASSIGN(LogBackend);
+
+  void addSink(std::unique_ptr<LogSink> sink);
+  void clearSinks();
+
+  inline void setOverflowPolicy(OverflowPolicy policy) {
+    policy_.store(policy, std::memory_order_relaxed);
   }
 
-  template<typename T, typename... Args>
-  void printHelper(std::ostream& out, T&& msg, Args&& ...args) {
-    out << std::forward<T>(msg);
-    printHelper(out, std::forward<Args>(args)...);
+  inline uint64 droppedCount() const {
+    return dropped_.load(std::memory_order_relaxed);
   }
+
+  // Arguments past kMaxRecordSize bytes are left out, lines are cut at kMaxLineLength
+  template<typename ...Args>
+  void push(LogLevel level, const std::string& name, Args&& ... args);
+
+  // Blocks until every message pushed before the call has reached the sinks
+  void flush();
+
+  // Drains the queues and stops the background thread, later messages are written synchronously
+  void shutdown();
+
+private:
+  struct Entry {
+    LogLevel level;
+    bool truncated;
+    uint16 size;
+    uint8 data[kMaxRecordSize];
+  };
+
+  struct ThreadQueue {
+    BELLUM_TRACK_MEMORY(LOGGING)
+
+    RingBuffer<Entry, kQueueCapacity> entries;
+  };
+
+  LogBackend();
+
+  ThreadQueue& threadQueue();
+  bool waitForSpace();
+  void run();
+  bool drain();
+  void writeEntry(const Entry& entry);
+  void writeToSinks(LogLevel level, const char* message, size_t length);
+
+  std::mutex queues_mutex_;
+  std::vector<std::shared_ptr<ThreadQueue>> queues_;
+  std::mutex sinks_mutex_;
+  std::vector<std::unique_ptr<LogSink>> sinks_;
+
+  std::atomic<OverflowPolicy> policy_;
+  std::atomic<uint64> dropped_;
+  uint64 reported_dropped_;
+
+  std::atomic<bool> running_;
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+  std::condition_variable flushed_;
+  uint64 flush_requested_;
+  uint64 flush_done_;
+  std::thread worker_;
 };
 
+template<LogLevel level, typename ...Args>
+void Logger::log(Args&& ... args) {
+  if (static_cast<int32>(level) < BELLUM_LOG_LEVEL) {
+    return;
+  }
+
+  LogBackend::instance().push(level, name_, std::forward<Args>(args)...);
+}
+
+template<typename ...Args>
+void LogBackend::push(LogLevel level, const std::string& name, Args&& ... args) {
+  auto fill = [&](Entry& entry) {
+    FormatRecordWriter writer{entry.data, sizeof(entry.data)};
+    writer.add(name);
+    writer.addAll(std::forward<Args>(args)...);
+    entry.level = level;
+    entry.truncated = writer.truncated();
+    entry.size = static_cast<uint16>(writer.size());
+  };
+
+  if (!running_.load(std::memory_order_acquire)) {
+    Entry entry;
+    fill(entry);
+    writeEntry(entry);
+    return;
+  }
+
+  ThreadQueue& queue = threadQueue();
+  while (!queue.entries.tryPush(fill)) {
+    if (!waitForSpace()) {
+      return;
+    }
+  }
+}
+
 }
 
 #endif
@@ -1,6 +1,8 @@
 #ifndef BELLUM_MACROS_H
 #define BELLUM_MACROS_H
 
+#include <iostream>
+
 #define DELETE_COPY_AND_ASSIGN(TypeName) \
   TypeName(const TypeName& copy) = delete; \
   TypeName operator=(const TypeName& copy) = delete
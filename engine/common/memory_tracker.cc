@@ -0,0 +1,147 @@
+#include "memory_tracker.h"
+#include <cstdlib>
+#include <fstream>
+#include <new>
+
+namespace bellum {
+
+std::array<MemoryTracker::Counters, static_cast<size_t>(MemoryTracker::Tag::COUNT)>
+  MemoryTracker::counters_;
+
+namespace {
+
+// Prefix of every tracked allocation, sized to keep the returned pointer max-aligned
+struct alignas(alignof(std::max_align_t)) AllocationHeader {
+  size_t size;
+  MemoryTracker::Tag tag;
+};
+
+}
+
+void* MemoryTracker::allocate(Tag tag, size_t size) {
+  void* block = std::malloc(sizeof(AllocationHeader) + size);
+  if (block == nullptr) {
+    throw std::bad_alloc{};
+  }
+
+  AllocationHeader* header = static_cast<AllocationHeader*>(block);
+  header->size = size;
+  header->tag = tag;
+  allocated(tag, size);
+  return header + 1;
+}
+
+void MemoryTracker::deallocate(void* pointer) {
+  if (pointer == nullptr) {
+    return;
+  }
+
+  AllocationHeader* header = static_cast<AllocationHeader*>(pointer) - 1;
+  freed(header->tag, header->size);
+  std::free(header);
+}
+
+void MemoryTracker::allocated(Tag tag, size_t bytes) {
+  Counters& counters = counters_[static_cast<size_t>(tag)];
+  int64 live = counters.live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+  counters.allocations.fetch_add(1, std::memory_order_relaxed);
+  counters.frame_allocations.fetch_add(1, std::memory_order_relaxed);
+  counters.frame_bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+  int64 peak = counters.peak_bytes.load(std::memory_order_relaxed);
+  while (live > peak &&
+         !counters.peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+}
+
+void MemoryTracker::freed(Tag tag, size_t bytes) {
+  counters_[static_cast<size_t>(tag)].live_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+MemoryTracker::Stats MemoryTracker::stats(Tag tag) {
+  const Counters& counters = counters_[static_cast<size_t>(tag)];
+  return {counters.live_bytes.load(std::memory_order_relaxed),
+          counters.peak_bytes.load(std::memory_order_relaxed),
+          counters.allocations.load(std::memory_order_relaxed),
+          counters.last_frame_allocations.load(std::memory_order_relaxed),
+          counters.last_frame_bytes.load(std::memory_order_relaxed)};
+}
+
+int64 MemoryTracker::totalLiveBytes() {
+  int64 total = 0;
+  for (const auto& counters : counters_) {
+    total += counters.live_bytes.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+void MemoryTracker::endFrame() {
+  for (auto& counters : counters_) {
+    counters.last_frame_allocations.store(
+      counters.frame_allocations.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    counters.last_frame_bytes.store(
+      counters.frame_bytes.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+}
+
+bool MemoryTracker::dump(const std::string& path) {
+  std::ofstream out{path};
+  if (!out.is_open()) {
+    return false;
+  }
+
+  bool json = path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0;
+
+  if (json) {
+    out << "{";
+  } else {
+    out << "tag,live_bytes,peak_bytes,allocations,frame_allocations,frame_bytes\n";
+  }
+
+  for (uint32 t = 0; t < static_cast<uint32>(Tag::COUNT); t++) {
+    Tag tag = static_cast<Tag>(t);
+    Stats s = stats(tag);
+
+    if (json) {
+      out << (t == 0 ? "\n" : ",\n");
+      out << "  \"" << tagName(tag) << "\": {"
+          << "\"live_bytes\": " << s.live_bytes << ", "
+          << "\"peak_bytes\": " << s.peak_bytes << ", "
+          << "\"allocations\": " << s.allocations << ", "
+          << "\"frame_allocations\": " << s.frame_allocations << ", "
+          << "\"frame_bytes\": " << s.frame_bytes << "}";
+    } else {
+      out << tagName(tag) << ',' << s.live_bytes << ',' << s.peak_bytes << ',' << s.allocations
+          << ',' << s.frame_allocations << ',' << s.frame_bytes << '\n';
+    }
+  }
+
+  if (json) {
+    out << "\n}\n";
+  }
+
+  return out.good();
+}
+
+const char* MemoryTracker::tagName(Tag tag) {
+  switch (tag) {
+    case Tag::SCENE:
+      return "scene";
+    case Tag::COMPONENTS:
+      return "components";
+    case Tag::MESH:
+      return "mesh";
+    case Tag::GPU_BUFFER:
+      return "gpu_buffer";
+    case Tag::SHADER:
+      return "shader";
+    case Tag::LOGGING:
+      return "logging";
+    case Tag::FRAME:
+      return "frame";
+    case Tag::COUNT:
+      break;
+  }
+  return "unknown";
+}
+
+}
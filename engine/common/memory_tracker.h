@@ -0,0 +1,81 @@
+#ifndef BELLUM_MEMORY_TRACKER_H
+#define BELLUM_MEMORY_TRACKER_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include "types.h"
+
+// Routes heap allocations of a class through the tracker under MemoryTracker::Tag::TagName
+#define BELLUM_TRACK_MEMORY(TagName) \
+  static void* operator new(size_t size) { \
+    return ::bellum::MemoryTracker::allocate(::bellum::MemoryTracker::Tag::TagName, size); \
+  } \
+  static void operator delete(void* pointer) { \
+    ::bellum::MemoryTracker::deallocate(pointer); \
+  }
+
+namespace bellum {
+
+// Live, peak and per-frame byte counters per subsystem. Memory is either allocated through the
+// tracker or reported with allocated/freed when it's owned elsewhere, like container storage or
+// GPU buffers. Safe to use from any thread.
+class MemoryTracker {
+public:
+  enum class Tag : uint8 {
+    SCENE,
+    COMPONENTS,
+    MESH,
+    GPU_BUFFER,
+    SHADER,
+    LOGGING,
+    FRAME,
+    COUNT
+  };
+
+  struct Stats {
+    int64 live_bytes;
+    int64 peak_bytes;
+    uint64 allocations;
+    // of the last complete frame
+    uint64 frame_allocations;
+    uint64 frame_bytes;
+  };
+
+  static void* allocate(Tag tag, size_t size);
+  static void deallocate(void* pointer);
+
+  static void allocated(Tag tag, size_t bytes);
+  static void freed(Tag tag, size_t bytes);
+
+  static Stats stats(Tag tag);
+  static int64 totalLiveBytes();
+
+  // Called once per frame, closes the per-frame counters
+  static void endFrame();
+
+  // Writes the stats of every tag as CSV, or as JSON if the path ends with '.json'
+  static bool dump(const std::string& path);
+
+  static const char* tagName(Tag tag);
+
+private:
+  struct Counters {
+    std::atomic<int64> live_bytes{0};
+    std::atomic<int64> peak_bytes{0};
+    std::atomic<uint64> allocations{0};
+    std::atomic<uint64> frame_allocations{0};
+    std::atomic<uint64> frame_bytes{0};
+    std::atomic<uint64> last_frame_allocations{0};
+    std::atomic<uint64> last_frame_bytes{0};
+  };
+
+  MemoryTracker() {}
+
+  static std::array<Counters, static_cast<size_t>(Tag::COUNT)> counters_;
+};
+
+}
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef BELLUM_RING_BUFFER_H
+#define BELLUM_RING_BUFFER_H
+
+#include <array>
+#include <atomic>
+#include "macros.h"
+#include "types.h"
+
+namespace bellum {
+
+// Bounded lock-free queue for exactly one producer and one consumer thread. Elements are
+// written and read in place, so large entries are never copied through temporaries.
+template<typename T, uint32 Capacity>
+class RingBuffer {
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                "Capacity must be a power of two");
+
+public:
+  RingBuffer()
+    : head_(0), tail_(0) {}
+
+  DELETE_COPY_AND_ASSIGN(RingBuffer);
+
+  // Producer only. 'fill' receives the slot to write, returns false if the buffer is full.
+  template<typename F>
+  inline bool tryPush(F&& fill) {
+    uint32 head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) == Capacity) {
+      return false;
+    }
+
+    fill(slots_[head & (Capacity - 1)]);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer only. 'consume' receives the oldest element, returns false if the buffer is empty.
+  template<typename F>
+  inline bool tryPop(F&& consume) {
+    uint32 tail = tail_.load(std::memory_order_relaxed);
+    if (tail == head_.load(std::memory_order_acquire)) {
+      return false;
+    }
+
+    consume(slots_[tail & (Capacity - 1)]);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  inline bool empty() const {
+    return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire);
+  }
+
+private:
+  // producer and consumer indices live on separate cache lines
+  alignas(64) std::atomic<uint32> head_;
+  alignas(64) std::atomic<uint32> tail_;
+  std::array<T, Capacity> slots_;
+};
+
+}
+
+#endif
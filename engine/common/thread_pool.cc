@@ -0,0 +1,52 @@
+#include "thread_pool.h"
+#include <algorithm>
+
+namespace bellum {
+
+ThreadPool::ThreadPool(uint32 threadCount)
+  : stopping_(false) {
+  if (threadCount == 0) {
+    uint32 hardware = std::thread::hardware_concurrency();
+    threadCount = std::max<uint32>(hardware, 2) - 1;
+  }
+
+  threads_.reserve(threadCount);
+  for (uint32 i = 0; i < threadCount; i++) {
+    threads_.emplace_back(&ThreadPool::run, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    stopping_ = true;
+    tasks_.clear();
+  }
+  wake_.notify_all();
+
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+void ThreadPool::run() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock{mutex_};
+      wake_.wait(lock, [this]() {
+        return stopping_ || !tasks_.empty();
+      });
+      if (stopping_) {
+        return;
+      }
+
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+
+    task();
+  }
+}
+
+}
@@ -0,0 +1,65 @@
+#ifndef BELLUM_THREAD_POOL_H
+#define BELLUM_THREAD_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "macros.h"
+#include "types.h"
+
+namespace bellum {
+
+// Fixed set of worker threads running submitted tasks in submission order. Tasks that haven't
+// started when the pool is destroyed are dropped, their futures report a broken promise.
+class ThreadPool {
+public:
+  // 0 picks one thread less than the hardware has, at least one
+  explicit ThreadPool(uint32 threadCount = 0);
+  ~ThreadPool();
+
+  DELETE_COPY_AND_ASSIGN(ThreadPool);
+
+  // Exceptions thrown by 'task' are rethrown from the future's get
+  template<typename F>
+  auto submit(F&& task) -> std::future<decltype(task())>;
+
+  inline uint32 threadCount() const {
+    return static_cast<uint32>(threads_.size());
+  }
+
+private:
+  void run();
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::deque<std::function<void()>> tasks_;
+  bool stopping_;
+  std::vector<std::thread> threads_;
+};
+
+template<typename F>
+auto ThreadPool::submit(F&& task) -> std::future<decltype(task())> {
+  // std::function needs a copyable target, the packaged task is shared instead
+  auto packaged =
+    std::make_shared<std::packaged_task<decltype(task())()>>(std::forward<F>(task));
+  std::future<decltype(task())> result = packaged->get_future();
+
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    tasks_.emplace_back([packaged]() {
+      (*packaged)();
+    });
+  }
+  wake_.notify_one();
+
+  return result;
+}
+
+}
+
+#endif
@@ -12,9 +12,13 @@ class Component {
   friend class Node;
 
 public:
+  BELLUM_TRACK_MEMORY(COMPONENTS)
+
   Component()
     : enabled_(true) {}
 
+  virtual ~Component() {}
+
   inline bool enabled() const {
     return enabled_;
   }
@@ -28,6 +32,8 @@ public:
   virtual void onEnable() {};
   virtual void onDisable() {};
   virtual void update() {};
+  // Right before rendering with late latching on, only for components next to the current camera
+  virtual void latch() {};
 
 protected:
   Node* node_;
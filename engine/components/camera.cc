@@ -9,11 +9,10 @@ Matrix4 Camera::viewProjection() const {
   return projection_ * view();
 }
 
-Matrix4 Camera::view() const {
+Affine3 Camera::view() const {
   Transform* t = &node_->transform();
 
-  return Matrix4::makeRotation(t->rotation().conjugated()) *
-         Matrix4::makeTranslation(-t->position());
+  return Affine3::makeTransformation(t->position(), late_rotation_ * t->rotation()).inversedRigid();
 }
 
 Vector3 Camera::worldToViewportPoint(const Vector3& worldPoint) const {
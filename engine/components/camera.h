@@ -4,6 +4,8 @@
 #include "../common.h"
 #include "../component.h"
 #include "../math/matrix4.h"
+#include "../math/affine3.h"
+#include "../math/quaternion.h"
 #include "../color.h"
 
 namespace bellum {
@@ -15,7 +17,8 @@ public:
   };
 
   Camera()
-    : clear_flags_(ClearFlags::SOLID_COLOR) {}
+    : clear_flags_(ClearFlags::SOLID_COLOR),
+      late_rotation_(Quaternion::identity()) {}
 
   const Matrix4& projection() const {
     return projection_;
@@ -41,8 +44,18 @@ public:
     clear_color_ = color;
   }
 
+  // World space rotation put in front of the node's rotation when rendering, for input that came
+  // in after the last tick. The transform itself never sees it.
+  const Quaternion& lateRotation() const {
+    return late_rotation_;
+  }
+
+  void setLateRotation(const Quaternion& rotation) {
+    late_rotation_ = rotation;
+  }
+
   Matrix4 viewProjection() const;
-  Matrix4 view() const;
+  Affine3 view() const;
   Vector3 worldToViewportPoint(const Vector3& worldPoint) const;
 
   static Camera* current() {
@@ -57,6 +70,7 @@ private:
   Matrix4 projection_;
   ClearFlags clear_flags_;
   Color clear_color_;
+  Quaternion late_rotation_;
 
   static Camera* current_;
 };
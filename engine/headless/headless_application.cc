@@ -0,0 +1,131 @@
+#include "headless_application.h"
+#include "../common/log_sink.h"
+#include "../profiling/frame_stats.h"
+#include "../profiling/profiler.h"
+#include "../render/render_stats.h"
+#include "../random.h"
+#include "../timing.h"
+
+namespace bellum {
+
+HeadlessApplication::HeadlessApplication()
+  : super::Application(), startup_ms_(0.0), frames_(0), succeeded_(false) {}
+
+void HeadlessApplication::start(std::vector<std::string> args) {
+  logger_ = std::make_unique<Logger>("Bellum");
+  frames_ = 0;
+  succeeded_ = false;
+
+  uint32 frameCount = 600;
+  uint32 ticksPerFrame = 1;
+  double targetUps = 60.0;
+  uint64 seed = 0;
+  std::string statsPath;
+  std::string tracePath;
+  std::string memoryPath;
+  bool validOptions = true;
+  {
+    // parse '--x=y' arguments
+    std::stringstream ss;
+
+    for(const auto& arg : args) {
+      if (arg.compare(0, 9, "--frames=") == 0) {
+        ss.str(arg.substr(9));
+        ss >> frameCount;
+      } else if (arg.compare(0, 8, "--ticks=") == 0) {
+        ss.str(arg.substr(8));
+        ss >> ticksPerFrame;
+      } else if (arg.compare(0, 7, "--seed=") == 0) {
+        ss.str(arg.substr(7));
+        ss >> seed;
+      } else if (arg.compare(0, 8, "--stats=") == 0) {
+        statsPath = arg.substr(8);
+        continue;
+      } else if (arg.compare(0, 8, "--trace=") == 0) {
+        tracePath = arg.substr(8);
+        continue;
+      } else if (arg.compare(0, 9, "--memory=") == 0) {
+        memoryPath = arg.substr(9);
+        continue;
+      } else {
+        logger_->error("Unknown option '", arg, "'");
+        validOptions = false;
+        continue;
+      }
+
+      if (ss.fail() || ss.get() != -1) {
+        logger_->error("Failed to parse '", arg, "'");
+        validOptions = false;
+      }
+
+      ss.clear();
+    }
+  }
+
+  if (ticksPerFrame == 0) {
+    logger_->error("'--ticks' must be at least 1");
+    validOptions = false;
+  }
+
+  if (!validOptions) {
+    LogBackend::instance().shutdown();
+    return;
+  }
+
+  // simulated time advances by the fixed step no matter how long a frame really takes
+  Time::setDeltaTime(static_cast<float>(1.0 / targetUps));
+  Time::setFps(static_cast<int32>(targetUps / ticksPerFrame));
+
+  if (!tracePath.empty()) {
+#ifdef BELLUM_PROFILE
+    Profiler::setThreadName("Main");
+    Profiler::setEnabled(true);
+#else
+    logger_->error("Built without BELLUM_PROFILE, '--trace' has no scopes to record");
+#endif
+  }
+
+  Random::seed(seed);
+  running_ = true;
+  succeeded_ = true;
+
+  try {
+    double startupStart = Time::currentMilliseconds();
+    super::onStart();
+    startup_ms_ = Time::currentMilliseconds() - startupStart;
+
+    while (running_ && frames_ < frameCount) {
+      double frameStart = Time::currentMilliseconds();
+      FrameStats::Sample sample{};
+      BELLUM_PROFILE_SCOPE("Frame");
+
+      for (uint32 i = 0; i < ticksPerFrame; i++) {
+        super::update();
+      }
+      double renderStart = Time::currentMilliseconds();
+      sample[FrameStats::Metric::UPDATE] = static_cast<float>(renderStart - frameStart);
+
+      super::render();
+      double frameEnd = Time::currentMilliseconds();
+      sample[FrameStats::Metric::RENDER] = static_cast<float>(frameEnd - renderStart);
+      sample[FrameStats::Metric::FRAME] = static_cast<float>(frameEnd - frameStart);
+      sample.render = RenderStats::last();
+      FrameStats::record(sample);
+      frames_++;
+    }
+  } catch (const std::exception& e) {
+    logger_->error(e.what());
+    succeeded_ = false;
+  }
+
+  super::onExit();
+
+  writeReports(statsPath, memoryPath, tracePath);
+  LogBackend::instance().shutdown();
+}
+
+void HeadlessApplication::exit() {
+  running_ = false;
+}
+
+}
@@ -0,0 +1,47 @@
+#ifndef BELLUM_HEADLESS_APPLICATION_H
+#define BELLUM_HEADLESS_APPLICATION_H
+
+#include "../application.h"
+
+namespace bellum {
+
+// Runs the current scene for a fixed number of frames without a window or GL context, as fast as
+// possible and with a fixed time step, so runs with the same arguments do the same work. Built in
+// place of the standalone application when BELLUM_HEADLESS is defined, in which case rendering
+// prepares draws but submits nothing.
+class HeadlessApplication : public Application {
+public:
+  HeadlessApplication();
+  DELETE_COPY_AND_ASSIGN(HeadlessApplication);
+
+  // Options are '--frames=', '--ticks=' (fixed updates per frame), '--seed=', '--stats=',
+  // '--memory=' and '--trace=', an unknown or malformed one fails the run before it starts
+  void start(std::vector<std::string> args) override;
+  void exit() override;
+
+  // Time spent in onStart, which includes making the scene
+  inline double startupMilliseconds() const {
+    return startup_ms_;
+  }
+
+  // Frames rendered by the last start
+  inline uint32 frames() const {
+    return frames_;
+  }
+
+  // False if the last start rejected its options and ran nothing, or the frame loop threw
+  inline bool succeeded() const {
+    return succeeded_;
+  }
+
+private:
+  using super = Application;
+
+  double startup_ms_;
+  uint32 frames_;
+  bool succeeded_;
+};
+
+}
+
+#endif
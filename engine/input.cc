@@ -1,61 +1,235 @@
 #include "input.h"
 #include <GLFW/glfw3.h>
+#include "input_recording.h"
+#include "timing.h"
 
 namespace bellum {
 
+constexpr uint32 Input::kQueueCapacity;
+
 GLFWwindow* Input::glfw_window_;
-bool Input::mouse_locked_;
-Vector2 Input::mouse_position_;
-Vector2 Input::mouse_delta_;
-float Input::scroll_x_;
-float Input::scroll_y_;
+Input::State Input::state_;
+RingBuffer<Input::Event, Input::kQueueCapacity> Input::queue_;
+std::vector<Input::Event> Input::events_;
+std::unique_ptr<InputRecording> Input::recording_;
+bool Input::replay_finished_;
+Vector2 Input::latched_position_;
+double Input::sample_time_;
+
+namespace {
+
+Input::Event::Action toAction(int action) {
+  switch (action) {
+    case GLFW_PRESS:
+      return Input::Event::Action::PRESS;
+    case GLFW_REPEAT:
+      return Input::Event::Action::REPEAT;
+    default:
+      return Input::Event::Action::RELEASE;
+  }
+}
+
+}
 
 void Input::setupCallbacks() {
+  glfwSetKeyCallback(glfw_window_, [](GLFWwindow* window, int key, int scancode, int action,
+                                      int mods) {
+    if (key >= 0 && key <= KEY_LAST) {
+      push(Event::Type::KEY, toAction(action), static_cast<uint16>(key), {});
+    }
+  });
+  glfwSetMouseButtonCallback(glfw_window_, [](GLFWwindow* window, int button, int action,
+                                              int mods) {
+    if (button >= 0 && button <= MOUSE_BUTTON_LAST) {
+      push(Event::Type::MOUSE_BUTTON, toAction(action), static_cast<uint16>(button), {});
+    }
+  });
   glfwSetScrollCallback(glfw_window_, [](GLFWwindow* window, double xoffset, double yoffset) {
-    scroll_x_ = static_cast<float>(xoffset);
-    scroll_y_ = static_cast<float>(yoffset);
+    push(Event::Type::SCROLL, Event::Action::PRESS, 0,
+         {static_cast<float>(xoffset), static_cast<float>(yoffset)});
+  });
+}
+
+void Input::push(Event::Type type, Event::Action action, uint16 code, Vector2 scroll) {
+  double time = Time::currentSeconds();
+  // a full queue drops the event, the tick sees the keys as they were before it
+  queue_.tryPush([&](Event& event) {
+    event = {type, action, code, scroll, time};
   });
 }
 
+bool Input::keyHeld(uint16 keyCode) {
+  return keyCode < kKeyCount && state_.keys[keyCode];
+}
+
+bool Input::keyDown(uint16 keyCode) {
+  return keyCode < kKeyCount && state_.keys_down[keyCode];
+}
+
+bool Input::keyUp(uint16 keyCode) {
+  return keyCode < kKeyCount && state_.keys_up[keyCode];
+}
+
 bool Input::keyPressed(uint16 keyCode) {
-  return glfwGetKey(glfw_window_, keyCode) == GLFW_PRESS;
+  return keyHeld(keyCode);
 }
 
 bool Input::keyReleased(uint16 keyCode) {
-  return glfwGetKey(glfw_window_, keyCode) == GLFW_RELEASE;
+  return !keyHeld(keyCode);
 }
 
 bool Input::keyRepeated(uint16 keyCode) {
-  return glfwGetKey(glfw_window_, keyCode) == GLFW_REPEAT;
+  return keyCode < kKeyCount && state_.keys_repeated[keyCode];
+}
+
+bool Input::mouseHeld(uint16 button) {
+  return button < kButtonCount && state_.buttons[button];
+}
+
+bool Input::mouseDown(uint16 button) {
+  return button < kButtonCount && state_.buttons_down[button];
+}
+
+bool Input::mouseUp(uint16 button) {
+  return button < kButtonCount && state_.buttons_up[button];
 }
 
 bool Input::mousePressed(uint16 button) {
-  return glfwGetMouseButton(glfw_window_, button) == GLFW_PRESS;
+  return mouseHeld(button);
 }
 
 bool Input::mouseReleased(uint16 button) {
-  return glfwGetMouseButton(glfw_window_, button) == GLFW_RELEASE;
+  return !mouseHeld(button);
 }
 
+// The window never repeats mouse buttons
 bool Input::mouseRepeated(uint16 button) {
-  return glfwGetMouseButton(glfw_window_, button) == GLFW_REPEAT;
+  return false;
 }
 
 void Input::setMouseLocked(bool locked) {
-  mouse_locked_ = locked;
-  glfwSetInputMode(glfw_window_, GLFW_CURSOR, locked ? GLFW_CURSOR_DISABLED : GLFW_CURSOR_NORMAL);
+  state_.mouse_locked = locked;
+  if (glfw_window_ != nullptr) {
+    glfwSetInputMode(glfw_window_, GLFW_CURSOR, locked ? GLFW_CURSOR_DISABLED : GLFW_CURSOR_NORMAL);
+  }
 }
 
-void Input::update() {
+bool Input::startRecording(const std::string& path, uint64 seed) {
+  recording_ = InputRecording::makeRecording(path, seed);
+  replay_finished_ = false;
+  return recording_ != nullptr;
+}
+
+bool Input::startReplay(const std::string& path, uint64& seed) {
+  recording_ = InputRecording::makeReplay(path);
+  replay_finished_ = false;
+  if (recording_ == nullptr) {
+    return false;
+  }
+
+  seed = recording_->seed();
+  return true;
+}
+
+void Input::stopRecording() {
+  recording_.reset();
+}
+
+bool Input::replaying() {
+  return recording_ != nullptr && recording_->replaying();
+}
+
+bool Input::replayFinished() {
+  return replay_finished_;
+}
+
+void Input::latch() {
+  if (glfw_window_ == nullptr || replaying()) {
+    return;
+  }
+
   double x, y;
   glfwGetCursorPos(glfw_window_, &x, &y);
-  Vector2 mp{static_cast<float>(x), static_cast<float>(y)};
+  latched_position_ = {static_cast<float>(x), static_cast<float>(y)};
+  sample_time_ = Time::currentSeconds();
+}
+
+void Input::apply(const Event& event, State& state) {
+  switch (event.type) {
+    case Event::Type::KEY:
+      if (event.code >= kKeyCount) {
+        break;
+      }
+      if (event.action == Event::Action::PRESS) {
+        state.keys.set(event.code);
+        state.keys_down.set(event.code);
+      } else if (event.action == Event::Action::RELEASE) {
+        state.keys.reset(event.code);
+        state.keys_up.set(event.code);
+      } else {
+        state.keys_repeated.set(event.code);
+      }
+      break;
+    case Event::Type::MOUSE_BUTTON:
+      if (event.code >= kButtonCount) {
+        break;
+      }
+      if (event.action == Event::Action::PRESS) {
+        state.buttons.set(event.code);
+        state.buttons_down.set(event.code);
+      } else if (event.action == Event::Action::RELEASE) {
+        state.buttons.reset(event.code);
+        state.buttons_up.set(event.code);
+      }
+      break;
+    case Event::Type::SCROLL:
+      state.scroll += event.scroll;
+      break;
+  }
+}
+
+void Input::update() {
+  events_.clear();
+  Vector2 mousePosition = state_.mouse_position;
+  bool mouseLocked = state_.mouse_locked;
+
+  if (replaying()) {
+    if (!recording_->read(events_, mousePosition, mouseLocked)) {
+      replay_finished_ = true;
+    }
+  } else {
+    auto drain = [](const Event& event) {
+      events_.push_back(event);
+    };
+    while (queue_.tryPop(drain)) {}
+
+    if (glfw_window_ != nullptr) {
+      double x, y;
+      glfwGetCursorPos(glfw_window_, &x, &y);
+      mousePosition = {static_cast<float>(x), static_cast<float>(y)};
+    }
+
+    if (recording_ != nullptr) {
+      recording_->write(events_, mousePosition, mouseLocked);
+    }
+  }
 
-  mouse_delta_ = mp - mouse_position_;
-  mouse_position_ = mp;
+  // held keys and buttons carry over, everything else only lasts for one tick
+  state_.keys_down.reset();
+  state_.keys_up.reset();
+  state_.keys_repeated.reset();
+  state_.buttons_down.reset();
+  state_.buttons_up.reset();
+  state_.scroll = {};
+  for (const Event& event : events_) {
+    apply(event, state_);
+  }
 
-  scroll_x_ = 0.0f;
-  scroll_y_ = 0.0f;
+  state_.mouse_delta = mousePosition - state_.mouse_position;
+  state_.mouse_position = mousePosition;
+  state_.mouse_locked = mouseLocked;
+  latched_position_ = mousePosition;
+  sample_time_ = Time::currentSeconds();
 }
 
 }
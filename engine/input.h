@@ -1,57 +1,113 @@
 #ifndef __BELLUM_INPUT_H__
 #define __BELLUM_INPUT_H__
 
+#include <bitset>
 #include "common.h"
+#include "common/ring_buffer.h"
 #include "math/vector2.h"
 
 struct GLFWwindow;
 
 namespace bellum {
 
+class InputRecording;
+
+// The window callbacks queue input events as they happen, once at the start of every tick the
+// queue is drained into the state all queries of the tick see. Presses and releases between two
+// ticks are never lost, a key tapped within one shows up as both down and up. The drained events
+// can be recorded to a file and replayed in place of the window.
 class Input {
   friend class Window;
 
 public:
+  struct Event {
+    enum class Type : uint8 {
+      KEY,
+      MOUSE_BUTTON,
+      SCROLL
+    };
+
+    enum class Action : uint8 {
+      PRESS,
+      RELEASE,
+      REPEAT
+    };
+
+    Type type;
+    Action action;
+    // key or mouse button
+    uint16 code;
+    Vector2 scroll;
+    // Time::currentSeconds when the window reported it
+    double time;
+  };
+
+  // Held during the tick
+  static bool keyHeld(uint16 keyCode);
+  // Went down or up at least once since the previous tick
+  static bool keyDown(uint16 keyCode);
+  static bool keyUp(uint16 keyCode);
+  // Same as keyHeld
   static bool keyPressed(uint16 keyCode);
   static bool keyReleased(uint16 keyCode);
+  // Repeated by the keyboard since the previous tick
   static bool keyRepeated(uint16 keyCode);
+  static bool mouseHeld(uint16 button);
+  static bool mouseDown(uint16 button);
+  static bool mouseUp(uint16 button);
   static bool mousePressed(uint16 button);
   static bool mouseReleased(uint16 button);
   static bool mouseRepeated(uint16 button);
   static void setMouseLocked(bool locked);
 
   static float scrollX() {
-    return scroll_x_;
+    return state_.scroll.x;
   }
   static float scrollY() {
-    return scroll_y_;
+    return state_.scroll.y;
   }
   static Vector2 mousePosition() {
-    return mouse_position_;
+    return state_.mouse_position;
   }
 
   static Vector2 mouseDelta() {
-    return mouse_delta_;
+    return state_.mouse_delta;
   }
 
   static bool mouseLocked() {
-    return mouse_locked_;
+    return state_.mouse_locked;
   }
 
-private:
-  static void setWindow(GLFWwindow* glfw_window) {
-    glfw_window_ = glfw_window;
+  // Cursor movement between the tick's sample and the last latch, zero until latch is called
+  static Vector2 lateMouseDelta() {
+    return latched_position_ - state_.mouse_position;
   }
 
-  static void setupCallbacks();
-  static void update();
+  // Time::currentSeconds of the newest cursor sample, from the tick or the last latch
+  static double sampleTime() {
+    return sample_time_;
+  }
 
-  static GLFWwindow* glfw_window_;
-  static bool mouse_locked_;
-  static Vector2 mouse_position_;
-  static Vector2 mouse_delta_;
-  static float scroll_x_;
-  static float scroll_y_;
+  // Every event drained at the start of this tick, oldest first
+  static const std::vector<Event>& events() {
+    return events_;
+  }
+
+  // Writes every following tick to 'path' along with the random seed of the run
+  static bool startRecording(const std::string& path, uint64 seed);
+  // Feeds the ticks of a recording back instead of polling the window, 'seed' receives the seed
+  // it was recorded with
+  static bool startReplay(const std::string& path, uint64& seed);
+  // Closes the current recording or replay
+  static void stopRecording();
+
+  static bool replaying();
+  // True once a replay has run out of ticks, input stays at the last recorded state
+  static bool replayFinished();
+
+  // Samples the cursor again without touching the tick's state, renderers can show movement that
+  // arrived after the last tick through lateMouseDelta. Does nothing while replaying.
+  static void latch();
 
 public:
   enum PrintableKeys : uint16 {
@@ -195,6 +251,45 @@ public:
     MOUSE_BUTTON_RIGHT = MOUSE_BUTTON_2,
     MOUSE_BUTTON_MIDDLE = MOUSE_BUTTON_3
   };
+
+private:
+  static constexpr size_t kKeyCount = KEY_LAST + 1;
+  static constexpr size_t kButtonCount = MOUSE_BUTTON_LAST + 1;
+  // Must be a power of two, events beyond it within one tick are dropped
+  static constexpr uint32 kQueueCapacity = 256;
+
+  struct State {
+    std::bitset<kKeyCount> keys;
+    std::bitset<kKeyCount> keys_down;
+    std::bitset<kKeyCount> keys_up;
+    std::bitset<kKeyCount> keys_repeated;
+    std::bitset<kButtonCount> buttons;
+    std::bitset<kButtonCount> buttons_down;
+    std::bitset<kButtonCount> buttons_up;
+    Vector2 mouse_position;
+    // difference to the previous tick
+    Vector2 mouse_delta;
+    Vector2 scroll;
+    bool mouse_locked;
+  };
+
+  static void setWindow(GLFWwindow* glfw_window) {
+    glfw_window_ = glfw_window;
+  }
+
+  static void setupCallbacks();
+  static void update();
+  static void push(Event::Type type, Event::Action action, uint16 code, Vector2 scroll);
+  static void apply(const Event& event, State& state);
+
+  static GLFWwindow* glfw_window_;
+  static State state_;
+  static RingBuffer<Event, kQueueCapacity> queue_;
+  static std::vector<Event> events_;
+  static std::unique_ptr<InputRecording> recording_;
+  static bool replay_finished_;
+  static Vector2 latched_position_;
+  static double sample_time_;
 };
 
 }
@@ -0,0 +1,135 @@
+#include "input_recording.h"
+#include "timing.h"
+
+namespace bellum {
+
+constexpr uint32 InputRecording::kMagic;
+constexpr uint32 InputRecording::kVersion;
+
+InputRecording::InputRecording(bool replaying, uint64 seed)
+  : replaying_(replaying), seed_(seed), ticks_(0), mouse_position_() {}
+
+template<typename T>
+inline void InputRecording::put(const T& value) {
+  file_.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+inline bool InputRecording::get(T& value) {
+  return static_cast<bool>(file_.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+std::unique_ptr<InputRecording> InputRecording::makeRecording(const std::string& path,
+                                                              uint64 seed) {
+  std::unique_ptr<InputRecording> recording{new InputRecording{false, seed}};
+  recording->file_.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!recording->file_) {
+    return nullptr;
+  }
+
+  recording->put(kMagic);
+  recording->put(kVersion);
+  recording->put(seed);
+  return recording;
+}
+
+std::unique_ptr<InputRecording> InputRecording::makeReplay(const std::string& path) {
+  std::unique_ptr<InputRecording> replay{new InputRecording{true, 0}};
+  replay->file_.open(path, std::ios::in | std::ios::binary);
+  if (!replay->file_) {
+    return nullptr;
+  }
+
+  uint32 magic, version;
+  if (!replay->get(magic) || !replay->get(version) || !replay->get(replay->seed_) ||
+      magic != kMagic || version != kVersion) {
+    return nullptr;
+  }
+  return replay;
+}
+
+void InputRecording::write(const std::vector<Input::Event>& events, const Vector2& mousePosition,
+                           bool mouseLocked) {
+  uint8 flags = 0;
+  if (!events.empty()) {
+    flags |= EVENTS;
+  }
+  if (mousePosition != mouse_position_) {
+    flags |= MOUSE_MOVED;
+  }
+  if (mouseLocked) {
+    flags |= MOUSE_LOCKED;
+  }
+  put(flags);
+
+  if (flags & EVENTS) {
+    put(static_cast<uint16>(events.size()));
+    for (const Input::Event& event : events) {
+      // type in the high nibble, action in the low one
+      put(static_cast<uint8>(static_cast<uint8>(event.type) << 4 |
+                             static_cast<uint8>(event.action)));
+      if (event.type == Input::Event::Type::SCROLL) {
+        put(event.scroll);
+      } else {
+        put(event.code);
+      }
+    }
+  }
+  if (flags & MOUSE_MOVED) {
+    put(mousePosition);
+  }
+
+  mouse_position_ = mousePosition;
+  ticks_++;
+}
+
+bool InputRecording::read(std::vector<Input::Event>& events, Vector2& mousePosition,
+                          bool& mouseLocked) {
+  uint8 flags;
+  if (!get(flags)) {
+    return false;
+  }
+
+  std::vector<Input::Event> read;
+  if (flags & EVENTS) {
+    uint16 count;
+    if (!get(count)) {
+      return false;
+    }
+
+    double time = Time::currentSeconds();
+    read.reserve(count);
+    for (uint16 i = 0; i < count; i++) {
+      uint8 packed;
+      if (!get(packed)) {
+        return false;
+      }
+
+      Input::Event event{};
+      event.type = static_cast<Input::Event::Type>(packed >> 4);
+      event.action = static_cast<Input::Event::Action>(packed & 0xF);
+      event.time = time;
+      if (event.type > Input::Event::Type::SCROLL || event.action > Input::Event::Action::REPEAT) {
+        return false;
+      }
+      if (event.type == Input::Event::Type::SCROLL ? !get(event.scroll) : !get(event.code)) {
+        return false;
+      }
+      read.push_back(event);
+    }
+  }
+
+  Vector2 position = mouse_position_;
+  if ((flags & MOUSE_MOVED) && !get(position)) {
+    return false;
+  }
+
+  events.insert(events.end(), read.begin(), read.end());
+  mousePosition = position;
+  mouseLocked = (flags & MOUSE_LOCKED) != 0;
+  mouse_position_ = position;
+  ticks_++;
+  return true;
+}
+
+}
@@ -0,0 +1,67 @@
+#ifndef BELLUM_INPUT_RECORDING_H
+#define BELLUM_INPUT_RECORDING_H
+
+#include <fstream>
+#include "common.h"
+#include "input.h"
+
+namespace bellum {
+
+// Binary file of the input of every tick. A header with the random seed of the run is followed by
+// a flag byte per tick, then only what the flags announce: the input events drained in the tick,
+// the mouse position if it moved. Ticks without input take one byte. Values are stored in native
+// byte order.
+class InputRecording {
+public:
+  DELETE_COPY_AND_ASSIGN(InputRecording);
+
+  // Return nullptr if the file can't be opened, or for a replay, isn't a recording
+  static std::unique_ptr<InputRecording> makeRecording(const std::string& path, uint64 seed);
+  static std::unique_ptr<InputRecording> makeReplay(const std::string& path);
+
+  inline bool replaying() const {
+    return replaying_;
+  }
+
+  inline uint64 seed() const {
+    return seed_;
+  }
+
+  inline uint64 ticks() const {
+    return ticks_;
+  }
+
+  // Event times aren't stored, replayed events are stamped with the time they are read at
+  void write(const std::vector<Input::Event>& events, const Vector2& mousePosition,
+             bool mouseLocked);
+  // Returns false at the end of the recording, the outputs are left untouched then
+  bool read(std::vector<Input::Event>& events, Vector2& mousePosition, bool& mouseLocked);
+
+private:
+  enum Flags : uint8 {
+    EVENTS = 1 << 0,
+    MOUSE_MOVED = 1 << 1,
+    MOUSE_LOCKED = 1 << 2
+  };
+
+  static constexpr uint32 kMagic = 0x52494C42; // 'BLIR'
+  static constexpr uint32 kVersion = 2;
+
+  InputRecording(bool replaying, uint64 seed);
+
+  template<typename T>
+  inline void put(const T& value);
+  template<typename T>
+  inline bool get(T& value);
+
+  std::fstream file_;
+  bool replaying_;
+  uint64 seed_;
+  uint64 ticks_;
+  // the last mouse position written or read
+  Vector2 mouse_position_;
+};
+
+}
+
+#endif
@@ -0,0 +1,369 @@
+#ifndef BELLUM_AFFINE3_H
+#define BELLUM_AFFINE3_H
+
+#include <ostream>
+#include <array>
+#include "math.h"
+#include "vector3.h"
+#include "quaternion.h"
+#include "matrix4.h"
+#include "simd.h"
+
+namespace bellum {
+
+// Affine transform, the upper 3x4 part of a Matrix4 whose last row is (0, 0, 0, 1). Column-major,
+// data[column * 3 + row], column 3 holds the translation. Composing and inverting skip the
+// constant row, use Matrix4 only where a projection is involved.
+struct Affine3 {
+  std::array<float, 12> data;
+
+  inline constexpr float get(int32 row, int32 column) const;
+  inline void set(int32 row, int32 column, float value);
+  inline float& operator[](size_t i);
+  inline constexpr const float& operator[](size_t i) const;
+
+  inline constexpr Vector3 getColumn(int32 i) const;
+  inline constexpr Vector3 translation() const;
+  inline void setTranslation(const Vector3& translation);
+
+  inline constexpr float determinant() const;
+  // General inverse, the linear part must not be singular
+  inline Affine3& inverse();
+  inline Affine3 inversed() const;
+  // Inverse of a rotation and translation
+  inline Affine3 inversedRigid() const;
+  // Inverse of a rotation, axis-aligned scale and translation, i.e. orthogonal columns
+  inline Affine3 inversedScaled() const;
+
+  inline constexpr Matrix4 toMatrix4() const;
+
+  inline static constexpr Vector3 multiplyPoint(const Affine3& a, const Vector3& point);
+  inline static constexpr Vector3 multiplyVector(const Affine3& a, const Vector3& v);
+
+  inline Affine3 operator*(const Affine3& a) const;
+  inline Affine3& operator*=(const Affine3& a);
+
+  inline static constexpr Affine3 fromMatrix4(const Matrix4& m);
+  inline static Affine3 makeTransformation(const Vector3& translation,
+                                           const Quaternion& rotation,
+                                           const Vector3& scale);
+  inline static Affine3 makeTransformation(const Vector3& translation,
+                                           const Quaternion& rotation);
+  inline static constexpr Affine3 makeTranslation(const Vector3& translation);
+  inline static constexpr Affine3 makeRotation(const Quaternion& q);
+  inline static constexpr Affine3 makeScale(const Vector3& scale);
+
+  inline static constexpr Affine3 identity();
+
+  friend std::ostream& operator<<(std::ostream& os, const Affine3& a);
+};
+
+inline constexpr float Affine3::get(int32 row, int32 column) const {
+  return data[column * 3 + row];
+}
+
+inline void Affine3::set(int32 row, int32 column, float value) {
+  data[column * 3 + row] = value;
+}
+
+inline float& Affine3::operator[](size_t i) {
+  return data[i];
+}
+
+inline constexpr const float& Affine3::operator[](size_t i) const {
+  return data[i];
+}
+
+inline constexpr Vector3 Affine3::getColumn(int32 i) const {
+  return {data[i * 3], data[i * 3 + 1], data[i * 3 + 2]};
+}
+
+inline constexpr Vector3 Affine3::translation() const {
+  return getColumn(3);
+}
+
+inline void Affine3::setTranslation(const Vector3& translation) {
+  data[9] = translation.x;
+  data[10] = translation.y;
+  data[11] = translation.z;
+}
+
+// Algebra
+inline constexpr float Affine3::determinant() const {
+  return data[0] * (data[4] * data[8] - data[5] * data[7]) -
+         data[3] * (data[1] * data[8] - data[2] * data[7]) +
+         data[6] * (data[1] * data[5] - data[2] * data[4]);
+}
+
+inline Affine3& Affine3::inverse() {
+  *this = inversed();
+  return *this;
+}
+
+inline Affine3 Affine3::inversed() const {
+  // adjugate of the 3x3 part, the translation follows as -inverse(L) * t
+  float c0 = data[4] * data[8] - data[5] * data[7];
+  float c1 = data[2] * data[7] - data[1] * data[8];
+  float c2 = data[1] * data[5] - data[2] * data[4];
+
+  float d = 1.0f / (data[0] * c0 + data[3] * c1 + data[6] * c2);
+
+  Affine3 result;
+  result[0] = c0 * d;
+  result[1] = c1 * d;
+  result[2] = c2 * d;
+  result[3] = (data[5] * data[6] - data[3] * data[8]) * d;
+  result[4] = (data[0] * data[8] - data[2] * data[6]) * d;
+  result[5] = (data[2] * data[3] - data[0] * data[5]) * d;
+  result[6] = (data[3] * data[7] - data[4] * data[6]) * d;
+  result[7] = (data[1] * data[6] - data[0] * data[7]) * d;
+  result[8] = (data[0] * data[4] - data[1] * data[3]) * d;
+  result.setTranslation(-multiplyVector(result, translation()));
+  return result;
+}
+
+inline Affine3 Affine3::inversedRigid() const {
+  // the transposed rotation
+  Affine3 result{
+    data[0], data[3], data[6],
+    data[1], data[4], data[7],
+    data[2], data[5], data[8],
+    0.0f, 0.0f, 0.0f
+  };
+  result.setTranslation(-multiplyVector(result, translation()));
+  return result;
+}
+
+inline Affine3 Affine3::inversedScaled() const {
+  // rows of the inverse are the columns divided by their squared length
+  float l0 = data[0] * data[0] + data[1] * data[1] + data[2] * data[2];
+  float l1 = data[3] * data[3] + data[4] * data[4] + data[5] * data[5];
+  float l2 = data[6] * data[6] + data[7] * data[7] + data[8] * data[8];
+#ifdef BELLUM_SIMD_SSE
+  alignas(16) float s[4];
+  _mm_store_ps(s, _mm_div_ps(_mm_set1_ps(1.0f), _mm_setr_ps(l0, l1, l2, 1.0f)));
+#else
+  float s[3] = {1.0f / l0, 1.0f / l1, 1.0f / l2};
+#endif
+
+  return {
+    data[0] * s[0], data[3] * s[1], data[6] * s[2],
+    data[1] * s[0], data[4] * s[1], data[7] * s[2],
+    data[2] * s[0], data[5] * s[1], data[8] * s[2],
+    -(data[0] * data[9] + data[1] * data[10] + data[2] * data[11]) * s[0],
+    -(data[3] * data[9] + data[4] * data[10] + data[5] * data[11]) * s[1],
+    -(data[6] * data[9] + data[7] * data[10] + data[8] * data[11]) * s[2]
+  };
+}
+
+inline constexpr Matrix4 Affine3::toMatrix4() const {
+  return {
+    data[0], data[1], data[2], 0.0f,
+    data[3], data[4], data[5], 0.0f,
+    data[6], data[7], data[8], 0.0f,
+    data[9], data[10], data[11], 1.0f
+  };
+}
+
+inline constexpr Vector3 Affine3::multiplyPoint(const Affine3& a, const Vector3& point) {
+  return {
+    point.x * a[0] + point.y * a[3] + point.z * a[6] + a[9],
+    point.x * a[1] + point.y * a[4] + point.z * a[7] + a[10],
+    point.x * a[2] + point.y * a[5] + point.z * a[8] + a[11]
+  };
+}
+
+inline constexpr Vector3 Affine3::multiplyVector(const Affine3& a, const Vector3& v) {
+  return {
+    v.x * a[0] + v.y * a[3] + v.z * a[6],
+    v.x * a[1] + v.y * a[4] + v.z * a[7],
+    v.x * a[2] + v.y * a[5] + v.z * a[8]
+  };
+}
+
+inline Affine3 Affine3::operator*(const Affine3& a) const {
+  Affine3 result;
+#ifdef BELLUM_SIMD_SSE
+  // 4 wide loads of 3 wide columns, the extra lane only ever reaches the unused lane of a result
+  __m128 c0 = _mm_loadu_ps(&data[0]);
+  __m128 c1 = _mm_loadu_ps(&data[3]);
+  __m128 c2 = _mm_loadu_ps(&data[6]);
+  __m128 t = simd::swizzle<1, 2, 3, 3>(_mm_loadu_ps(&data[8]));
+
+  __m128 v0 = _mm_loadu_ps(&a[0]);
+  __m128 v1 = _mm_loadu_ps(&a[3]);
+  __m128 v2 = _mm_loadu_ps(&a[6]);
+  __m128 v3 = _mm_loadu_ps(&a[8]);
+  __m128 r0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, simd::splat<0>(v0)),
+                                    _mm_mul_ps(c1, simd::splat<1>(v0))),
+                         _mm_mul_ps(c2, simd::splat<2>(v0)));
+  __m128 r1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, simd::splat<0>(v1)),
+                                    _mm_mul_ps(c1, simd::splat<1>(v1))),
+                         _mm_mul_ps(c2, simd::splat<2>(v1)));
+  __m128 r2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, simd::splat<0>(v2)),
+                                    _mm_mul_ps(c1, simd::splat<1>(v2))),
+                         _mm_mul_ps(c2, simd::splat<2>(v2)));
+  __m128 r3 = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, simd::splat<1>(v3)),
+                                               _mm_mul_ps(c1, simd::splat<2>(v3))),
+                                    _mm_mul_ps(c2, simd::splat<3>(v3))),
+                         t);
+
+  // pack the four 3 wide columns into three registers
+  __m128 r01 = simd::shuffle<2, 2, 0, 0>(r0, r1);
+  __m128 r23 = simd::shuffle<2, 2, 0, 0>(r2, r3);
+  _mm_storeu_ps(&result[0], simd::shuffle<0, 1, 0, 2>(r0, r01));
+  _mm_storeu_ps(&result[4], simd::shuffle<1, 2, 0, 1>(r1, r2));
+  _mm_storeu_ps(&result[8], simd::shuffle<0, 2, 1, 2>(r23, r3));
+#else
+  for (int32 column = 0; column < 4; column++) {
+    Vector3 c = multiplyVector(*this, a.getColumn(column));
+    result[column * 3] = c.x;
+    result[column * 3 + 1] = c.y;
+    result[column * 3 + 2] = c.z;
+  }
+
+  result[9] += data[9];
+  result[10] += data[10];
+  result[11] += data[11];
+#endif
+  return result;
+}
+
+inline Affine3& Affine3::operator*=(const Affine3& a) {
+  *this = *this * a;
+  return *this;
+}
+
+// Transforms a point
+inline Vector3 operator*(const Affine3& a, const Vector3& point) {
+  return Affine3::multiplyPoint(a, point);
+}
+
+// Same as m * a.toMatrix4() with the constant row of a folded in
+inline Matrix4 operator*(const Matrix4& m, const Affine3& a) {
+  Matrix4 result;
+#ifdef BELLUM_SIMD_SSE
+  __m128 c0 = simd::load(&m[0]);
+  __m128 c1 = simd::load(&m[4]);
+  __m128 c2 = simd::load(&m[8]);
+  __m128 c3 = simd::load(&m[12]);
+
+  for (int32 column = 0; column < 3; column++) {
+    __m128 v = _mm_setr_ps(a[column * 3], a[column * 3 + 1], a[column * 3 + 2], 0.0f);
+    simd::store(&result[column * 4], simd::combine(c0, c1, c2, c3, v));
+  }
+  simd::store(&result[12], simd::combine(c0, c1, c2, c3, _mm_setr_ps(a[9], a[10], a[11], 1.0f)));
+#else
+  for (int32 column = 0; column < 4; column++) {
+    float w = column == 3 ? 1.0f : 0.0f;
+    for (int32 row = 0; row < 4; row++) {
+      result.set(row, column, m.get(row, 0) * a.get(0, column) + m.get(row, 1) * a.get(1, column) +
+                              m.get(row, 2) * a.get(2, column) + m.get(row, 3) * w);
+    }
+  }
+#endif
+  return result;
+}
+
+// Factory methods
+inline constexpr Affine3 Affine3::fromMatrix4(const Matrix4& m) {
+  return {
+    m[0], m[1], m[2],
+    m[4], m[5], m[6],
+    m[8], m[9], m[10],
+    m[12], m[13], m[14]
+  };
+}
+
+inline Affine3 Affine3::makeTransformation(const Vector3& translation,
+                                           const Quaternion& rotation,
+                                           const Vector3& scale) {
+  Affine3 result = makeRotation(rotation);
+  for (int32 i = 0; i < 3; i++) {
+    result[i] *= scale.x;
+    result[3 + i] *= scale.y;
+    result[6 + i] *= scale.z;
+  }
+  result.setTranslation(translation);
+  return result;
+}
+
+inline Affine3 Affine3::makeTransformation(const Vector3& translation,
+                                           const Quaternion& rotation) {
+  Affine3 result = makeRotation(rotation);
+  result.setTranslation(translation);
+  return result;
+}
+
+inline constexpr Affine3 Affine3::makeTranslation(const Vector3& translation) {
+  return {
+    1.0f, 0.0f, 0.0f,
+    0.0f, 1.0f, 0.0f,
+    0.0f, 0.0f, 1.0f,
+    translation.x, translation.y, translation.z
+  };
+}
+
+inline constexpr Affine3 Affine3::makeRotation(const Quaternion& q) {
+  float x2 = q.x + q.x;
+  float y2 = q.y + q.y;
+  float z2 = q.z + q.z;
+
+  float xx2 = q.x * x2;
+  float yy2 = q.y * y2;
+  float zz2 = q.z * z2;
+  float xy2 = q.x * y2;
+  float xz2 = q.x * z2;
+  float yz2 = q.y * z2;
+  float wx2 = q.w * x2;
+  float wy2 = q.w * y2;
+  float wz2 = q.w * z2;
+
+  return {
+    1.0f - yy2 - zz2, xy2 + wz2, xz2 - wy2,
+    xy2 - wz2, 1.0f - xx2 - zz2, yz2 + wx2,
+    xz2 + wy2, yz2 - wx2, 1.0f - xx2 - yy2,
+    0.0f, 0.0f, 0.0f
+  };
+}
+
+inline constexpr Affine3 Affine3::makeScale(const Vector3& scale) {
+  return {
+    scale.x, 0.0f, 0.0f,
+    0.0f, scale.y, 0.0f,
+    0.0f, 0.0f, scale.z,
+    0.0f, 0.0f, 0.0f
+  };
+}
+
+inline constexpr Affine3 Affine3::identity() {
+  return {
+    1.0f, 0.0f, 0.0f,
+    0.0f, 1.0f, 0.0f,
+    0.0f, 0.0f, 1.0f,
+    0.0f, 0.0f, 0.0f
+  };
+}
+
+inline std::ostream& operator<<(std::ostream& os, const Affine3& a) {
+  os << "Affine3(" << '\n';
+  for (int32 row = 0; row < 3; row++) {
+    os << " " << a.get(row, 0) << ", " << a.get(row, 1) << ", " << a.get(row, 2) << ", "
+       << a.get(row, 3) << ",\n";
+  }
+  os << ')';
+  return os;
+}
+
+inline void formatValue(FormatBuffer& out, const Affine3& a) {
+  out << "Affine3(\n";
+  for (int32 row = 0; row < 3; row++) {
+    out << ' ' << a.get(row, 0) << ", " << a.get(row, 1) << ", " << a.get(row, 2) << ", "
+        << a.get(row, 3) << ",\n";
+  }
+  out << ')';
+}
+
+}
+
+#endif
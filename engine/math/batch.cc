@@ -0,0 +1,305 @@
+#include "batch.h"
+#include <algorithm>
+
+namespace bellum {
+
+static_assert(sizeof(Vector3) == 3 * sizeof(float), "Batch kernels expect tightly packed Vector3");
+
+#ifdef BELLUM_SIMD_SSE
+
+namespace {
+
+// x, y and z of four consecutive vectors
+struct Lanes {
+  __m128 x, y, z;
+};
+
+inline Lanes load4(const Vector3* p) {
+  const float* f = &p->x;
+  __m128 m0 = _mm_loadu_ps(f);      // x0 y0 z0 x1
+  __m128 m1 = _mm_loadu_ps(f + 4);  // y1 z1 x2 y2
+  __m128 m2 = _mm_loadu_ps(f + 8);  // z2 x3 y3 z3
+
+  Lanes v;
+  v.x = simd::shuffle<0, 3, 0, 2>(m0, simd::shuffle<2, 2, 1, 1>(m1, m2));
+  v.y = simd::shuffle<0, 2, 0, 2>(simd::shuffle<1, 1, 0, 0>(m0, m1),
+                                  simd::shuffle<3, 3, 2, 2>(m1, m2));
+  v.z = simd::shuffle<0, 2, 0, 3>(simd::shuffle<2, 2, 1, 1>(m0, m1), m2);
+  return v;
+}
+
+inline void store4(Vector3* p, const Lanes& v) {
+  float* f = &p->x;
+  _mm_storeu_ps(f, simd::shuffle<0, 2, 0, 2>(simd::shuffle<0, 0, 0, 0>(v.x, v.y),
+                                             simd::shuffle<0, 0, 1, 1>(v.z, v.x)));
+  _mm_storeu_ps(f + 4, simd::shuffle<0, 2, 0, 2>(simd::shuffle<1, 1, 1, 1>(v.y, v.z),
+                                                 simd::shuffle<2, 2, 2, 2>(v.x, v.y)));
+  _mm_storeu_ps(f + 8, simd::shuffle<0, 2, 0, 2>(simd::shuffle<2, 2, 3, 3>(v.z, v.x),
+                                                 simd::shuffle<3, 3, 3, 3>(v.y, v.z)));
+}
+
+inline __m128 crossLanes(__m128 ax, __m128 ay, __m128 az, __m128 bx, __m128 by, __m128 bz,
+                          __m128& y, __m128& z) {
+  y = _mm_sub_ps(_mm_mul_ps(az, bx), _mm_mul_ps(ax, bz));
+  z = _mm_sub_ps(_mm_mul_ps(ax, by), _mm_mul_ps(ay, bx));
+  return _mm_sub_ps(_mm_mul_ps(ay, bz), _mm_mul_ps(az, by));
+}
+
+// Runs kernel over groups of four, the remainder is padded with copies of its first element
+template<typename Kernel>
+void forEach4(const Vector3* in, Vector3* out, size_t count, Kernel kernel) {
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    Lanes v = load4(in + i);
+    kernel(v);
+    store4(out + i, v);
+  }
+
+  if (i < count) {
+    Vector3 rest[4] = {in[i], in[i], in[i], in[i]};
+    std::copy(in + i, in + count, rest);
+    Lanes v = load4(rest);
+    kernel(v);
+    store4(rest, v);
+    std::copy(rest, rest + (count - i), out + i);
+  }
+}
+
+// Column coefficients of a transform, splatted once per call
+struct Columns {
+  __m128 c[12];
+
+  Columns(const float* c0, const float* c1, const float* c2, const float* c3) {
+    const float* columns[] = {c0, c1, c2, c3};
+    for (int32 i = 0; i < 4; i++) {
+      for (int32 row = 0; row < 3; row++) {
+        c[i * 3 + row] = _mm_set1_ps(columns[i][row]);
+      }
+    }
+  }
+
+  inline void multiply(Lanes& v, bool point) const {
+    __m128 x = _mm_add_ps(_mm_add_ps(_mm_mul_ps(v.x, c[0]), _mm_mul_ps(v.y, c[3])),
+                          _mm_mul_ps(v.z, c[6]));
+    __m128 y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(v.x, c[1]), _mm_mul_ps(v.y, c[4])),
+                          _mm_mul_ps(v.z, c[7]));
+    __m128 z = _mm_add_ps(_mm_add_ps(_mm_mul_ps(v.x, c[2]), _mm_mul_ps(v.y, c[5])),
+                          _mm_mul_ps(v.z, c[8]));
+    if (point) {
+      x = _mm_add_ps(x, c[9]);
+      y = _mm_add_ps(y, c[10]);
+      z = _mm_add_ps(z, c[11]);
+    }
+    v = {x, y, z};
+  }
+};
+
+void transform(const Columns& columns, bool point, const Vector3* in, Vector3* out,
+               size_t count) {
+  forEach4(in, out, count, [&](Lanes& v) {
+    columns.multiply(v, point);
+  });
+}
+
+}
+
+void Batch::transformPoints(const Matrix4& m, const Vector3* in, Vector3* out, size_t count) {
+  transform({&m[0], &m[4], &m[8], &m[12]}, true, in, out, count);
+}
+
+void Batch::transformPoints(const Affine3& a, const Vector3* in, Vector3* out, size_t count) {
+  transform({&a[0], &a[3], &a[6], &a[9]}, true, in, out, count);
+}
+
+void Batch::transformVectors(const Matrix4& m, const Vector3* in, Vector3* out, size_t count) {
+  transform({&m[0], &m[4], &m[8], &m[12]}, false, in, out, count);
+}
+
+void Batch::transformVectors(const Affine3& a, const Vector3* in, Vector3* out, size_t count) {
+  transform({&a[0], &a[3], &a[6], &a[9]}, false, in, out, count);
+}
+
+void Batch::rotate(const Quaternion& q, const Vector3* in, Vector3* out, size_t count) {
+  __m128 qx = _mm_set1_ps(q.x);
+  __m128 qy = _mm_set1_ps(q.y);
+  __m128 qz = _mm_set1_ps(q.z);
+  __m128 qw = _mm_set1_ps(q.w);
+
+  // v + w t + q.xyz x t with t = 2 q.xyz x v, as in operator*(Quaternion, Vector3)
+  forEach4(in, out, count, [&](Lanes& v) {
+    __m128 ty, tz;
+    __m128 tx = crossLanes(qx, qy, qz, v.x, v.y, v.z, ty, tz);
+    tx = _mm_add_ps(tx, tx);
+    ty = _mm_add_ps(ty, ty);
+    tz = _mm_add_ps(tz, tz);
+
+    __m128 cy, cz;
+    __m128 cx = crossLanes(qx, qy, qz, tx, ty, tz, cy, cz);
+    v.x = _mm_add_ps(_mm_add_ps(v.x, _mm_mul_ps(qw, tx)), cx);
+    v.y = _mm_add_ps(_mm_add_ps(v.y, _mm_mul_ps(qw, ty)), cy);
+    v.z = _mm_add_ps(_mm_add_ps(v.z, _mm_mul_ps(qw, tz)), cz);
+  });
+}
+
+void Batch::normalize(Vector3* values, size_t count) {
+  __m128 zero = _mm_setzero_ps();
+
+  forEach4(values, values, count, [&](Lanes& v) {
+    __m128 m = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(v.x, v.x), _mm_mul_ps(v.y, v.y)),
+                                      _mm_mul_ps(v.z, v.z)));
+    __m128 keep = _mm_cmpeq_ps(m, zero);
+    v.x = _mm_or_ps(_mm_and_ps(keep, v.x), _mm_andnot_ps(keep, _mm_div_ps(v.x, m)));
+    v.y = _mm_or_ps(_mm_and_ps(keep, v.y), _mm_andnot_ps(keep, _mm_div_ps(v.y, m)));
+    v.z = _mm_or_ps(_mm_and_ps(keep, v.z), _mm_andnot_ps(keep, _mm_div_ps(v.z, m)));
+  });
+}
+
+void Batch::dot(const Vector3* a, const Vector3* b, float* out, size_t count) {
+  auto kernel = [](const Lanes& u, const Lanes& v) {
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(u.x, v.x), _mm_mul_ps(u.y, v.y)),
+                      _mm_mul_ps(u.z, v.z));
+  };
+
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    _mm_storeu_ps(out + i, kernel(load4(a + i), load4(b + i)));
+  }
+
+  if (i < count) {
+    Vector3 restA[4] = {a[i], a[i], a[i], a[i]};
+    Vector3 restB[4] = {b[i], b[i], b[i], b[i]};
+    std::copy(a + i, a + count, restA);
+    std::copy(b + i, b + count, restB);
+
+    float result[4];
+    _mm_storeu_ps(result, kernel(load4(restA), load4(restB)));
+    std::copy(result, result + (count - i), out + i);
+  }
+}
+
+void Batch::cross(const Vector3* a, const Vector3* b, Vector3* out, size_t count) {
+  auto kernel = [](const Lanes& u, const Lanes& v) {
+    Lanes result;
+    result.x = crossLanes(u.x, u.y, u.z, v.x, v.y, v.z, result.y, result.z);
+    return result;
+  };
+
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    store4(out + i, kernel(load4(a + i), load4(b + i)));
+  }
+
+  if (i < count) {
+    Vector3 restA[4] = {a[i], a[i], a[i], a[i]};
+    Vector3 restB[4] = {b[i], b[i], b[i], b[i]};
+    std::copy(a + i, a + count, restA);
+    std::copy(b + i, b + count, restB);
+
+    Vector3 result[4];
+    store4(result, kernel(load4(restA), load4(restB)));
+    std::copy(result, result + (count - i), out + i);
+  }
+}
+
+void Batch::minMax(const Vector3* values, size_t count, Vector3& min, Vector3& max) {
+  if (count == 0) {
+    min = max = Vector3{};
+    return;
+  }
+
+  Lanes lo{_mm_set1_ps(values[0].x), _mm_set1_ps(values[0].y), _mm_set1_ps(values[0].z)};
+  Lanes hi = lo;
+
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    Lanes v = load4(values + i);
+    lo = {_mm_min_ps(lo.x, v.x), _mm_min_ps(lo.y, v.y), _mm_min_ps(lo.z, v.z)};
+    hi = {_mm_max_ps(hi.x, v.x), _mm_max_ps(hi.y, v.y), _mm_max_ps(hi.z, v.z)};
+  }
+
+  Vector3 lanes[4];
+  store4(lanes, lo);
+  min = lanes[0];
+  for (int32 lane = 1; lane < 4; lane++) {
+    min = Vector3::min(min, lanes[lane]);
+  }
+
+  store4(lanes, hi);
+  max = lanes[0];
+  for (int32 lane = 1; lane < 4; lane++) {
+    max = Vector3::max(max, lanes[lane]);
+  }
+
+  for (; i < count; i++) {
+    min = Vector3::min(min, values[i]);
+    max = Vector3::max(max, values[i]);
+  }
+}
+
+#else
+
+void Batch::transformPoints(const Matrix4& m, const Vector3* in, Vector3* out, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = Matrix4::multiplyPoint(m, in[i]);
+  }
+}
+
+void Batch::transformPoints(const Affine3& a, const Vector3* in, Vector3* out, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = Affine3::multiplyPoint(a, in[i]);
+  }
+}
+
+void Batch::transformVectors(const Matrix4& m, const Vector3* in, Vector3* out, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = Matrix4::multiplyVector(m, in[i]);
+  }
+}
+
+void Batch::transformVectors(const Affine3& a, const Vector3* in, Vector3* out, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = Affine3::multiplyVector(a, in[i]);
+  }
+}
+
+void Batch::rotate(const Quaternion& q, const Vector3* in, Vector3* out, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = q * in[i];
+  }
+}
+
+void Batch::normalize(Vector3* values, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    values[i].normalize();
+  }
+}
+
+void Batch::dot(const Vector3* a, const Vector3* b, float* out, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = Vector3::dot(a[i], b[i]);
+  }
+}
+
+void Batch::cross(const Vector3* a, const Vector3* b, Vector3* out, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = Vector3::cross(a[i], b[i]);
+  }
+}
+
+void Batch::minMax(const Vector3* values, size_t count, Vector3& min, Vector3& max) {
+  if (count == 0) {
+    min = max = Vector3{};
+    return;
+  }
+
+  min = values[0];
+  max = values[0];
+  for (size_t i = 1; i < count; i++) {
+    min = Vector3::min(min, values[i]);
+    max = Vector3::max(max, values[i]);
+  }
+}
+
+#endif
+
+}
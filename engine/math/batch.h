@@ -0,0 +1,43 @@
+#ifndef BELLUM_BATCH_H
+#define BELLUM_BATCH_H
+
+#include "../common.h"
+#include "vector3.h"
+#include "quaternion.h"
+#include "matrix4.h"
+#include "affine3.h"
+
+namespace bellum {
+
+// Kernels over contiguous arrays of vectors. Four vectors at a time are transposed into
+// x, y and z registers, the remainder goes through the same kernel padded to four. Results match
+// the per-element Vector3, Matrix4 and Quaternion operations within float rounding. Input and
+// output may be the same array.
+class Batch {
+public:
+  // Same as Matrix4::multiplyPoint for each element
+  static void transformPoints(const Matrix4& m, const Vector3* in, Vector3* out, size_t count);
+  static void transformPoints(const Affine3& a, const Vector3* in, Vector3* out, size_t count);
+  // Same as Matrix4::multiplyVector for each element
+  static void transformVectors(const Matrix4& m, const Vector3* in, Vector3* out, size_t count);
+  static void transformVectors(const Affine3& a, const Vector3* in, Vector3* out, size_t count);
+
+  // Same as q * v for each element, q must be a unit quaternion
+  static void rotate(const Quaternion& q, const Vector3* in, Vector3* out, size_t count);
+
+  // Zero-length vectors are left unchanged
+  static void normalize(Vector3* values, size_t count);
+
+  static void dot(const Vector3* a, const Vector3* b, float* out, size_t count);
+  static void cross(const Vector3* a, const Vector3* b, Vector3* out, size_t count);
+
+  // Component-wise min and max over all values, zero for an empty array
+  static void minMax(const Vector3* values, size_t count, Vector3& min, Vector3& max);
+
+private:
+  Batch() {}
+};
+
+}
+
+#endif
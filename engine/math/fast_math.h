@@ -0,0 +1,208 @@
+#ifndef BELLUM_FAST_MATH_H
+#define BELLUM_FAST_MATH_H
+
+#include <cmath>
+#include <cstring>
+#include "../common.h"
+#include "simd.h"
+
+namespace bellum {
+
+// Accuracy tier of the Math functions that take a template parameter, e.g. Math::sin<FAST>(x)
+enum class Precision : uint8 {
+  PRECISE,
+  FAST
+};
+
+// Polynomial approximations without calls into libm. Errors are absolute unless noted and were
+// measured against double precision std:: functions. The SSE variants compute exactly what the
+// scalar versions do, four lanes at a time.
+class FastMath {
+public:
+  // Max error 1e-7 for |x| < 8192, accuracy degrades slowly beyond that
+  static inline void sincos(float x, float& s, float& c);
+  static inline float sin(float x);
+  static inline float cos(float x);
+
+  // Max error 2e-6 rad
+  static inline float atan2(float y, float x);
+
+  // Max error 7e-5 rad, x in [-1, 1]
+  static inline float acos(float x);
+
+  // Max relative error 5e-6, x > 0
+  static inline float rsqrt(float x);
+  // Max relative error 5e-6, 0 for x <= 0
+  static inline float sqrt(float x);
+
+  // Array version of sincos, the output arrays may not overlap the input
+  static inline void sincos(const float* x, float* s, float* c, size_t count);
+
+#ifdef BELLUM_SIMD_SSE
+  static inline void sincos4(__m128 x, __m128& s, __m128& c);
+  static inline __m128 rsqrt4(__m128 x);
+#endif
+
+private:
+  // pi / 2 split into three parts, the first two have trailing zero bits so multiples of them
+  // subtract exactly (Cody-Waite reduction)
+  static constexpr float kPiOver2A = 1.5703125f;
+  static constexpr float kPiOver2B = 4.837512969970703125e-4f;
+  static constexpr float kPiOver2C = 7.54978995489188216e-8f;
+  static constexpr float k2OverPi = 0.636619772367581343f;
+  static constexpr float kPi = 3.14159265358979323846f;
+  static constexpr float kPiOver2 = 1.57079632679489661923f;
+
+  // minimax polynomials on [-pi/4, pi/4]
+  static constexpr float kSin1 = -1.6666654611e-1f;
+  static constexpr float kSin2 = 8.3321608736e-3f;
+  static constexpr float kSin3 = -1.9515295891e-4f;
+  static constexpr float kCos1 = 4.166664568298827e-2f;
+  static constexpr float kCos2 = -1.388731625493765e-3f;
+  static constexpr float kCos3 = 2.443315711809948e-5f;
+
+  FastMath() {}
+};
+
+inline void FastMath::sincos(float x, float& s, float& c) {
+  // reduce to r in [-pi/4, pi/4] and the quadrant q
+  float qf = x * k2OverPi;
+  int32 q = static_cast<int32>(qf + (qf >= 0.0f ? 0.5f : -0.5f));
+  float fq = static_cast<float>(q);
+  float r = ((x - fq * kPiOver2A) - fq * kPiOver2B) - fq * kPiOver2C;
+
+  float r2 = r * r;
+  float ps = r + r * r2 * (kSin1 + r2 * (kSin2 + r2 * kSin3));
+  float pc = 1.0f - 0.5f * r2 + r2 * r2 * (kCos1 + r2 * (kCos2 + r2 * kCos3));
+
+  s = (q & 1) ? pc : ps;
+  c = (q & 1) ? ps : pc;
+  if (q & 2) {
+    s = -s;
+  }
+  if ((q + 1) & 2) {
+    c = -c;
+  }
+}
+
+inline float FastMath::sin(float x) {
+  float s, c;
+  sincos(x, s, c);
+  return s;
+}
+
+inline float FastMath::cos(float x) {
+  float s, c;
+  sincos(x, s, c);
+  return c;
+}
+
+inline float FastMath::atan2(float y, float x) {
+  float ax = x < 0.0f ? -x : x;
+  float ay = y < 0.0f ? -y : y;
+  float mx = ax < ay ? ay : ax;
+  float mn = ax < ay ? ax : ay;
+  if (mx == 0.0f) {
+    return 0.0f;
+  }
+
+  // atan on [0, 1], then mirrored into the right octant
+  float a = mn / mx;
+  float s = a * a;
+  float r = a * (0.99997726f + s * (-0.33262347f + s * (0.19354346f + s * (-0.11643287f +
+            s * (0.05265332f + s * -0.01172120f)))));
+
+  if (ay > ax) {
+    r = kPiOver2 - r;
+  }
+  if (x < 0.0f) {
+    r = kPi - r;
+  }
+  return y < 0.0f ? -r : r;
+}
+
+inline float FastMath::acos(float x) {
+  float ax = x < 0.0f ? -x : x;
+  float r = std::sqrt(1.0f - ax) * (1.5707288f + ax * (-0.2121144f + ax * (0.0742610f +
+            ax * -0.0187293f)));
+  return x < 0.0f ? kPi - r : r;
+}
+
+inline float FastMath::rsqrt(float x) {
+#ifdef BELLUM_SIMD_SSE
+  return _mm_cvtss_f32(rsqrt4(_mm_set_ss(x)));
+#else
+  // bit level estimate refined by two Newton steps
+  uint32 i;
+  std::memcpy(&i, &x, sizeof(i));
+  i = 0x5F375A86u - (i >> 1);
+  float y;
+  std::memcpy(&y, &i, sizeof(y));
+  y = y * (1.5f - 0.5f * x * y * y);
+  return y * (1.5f - 0.5f * x * y * y);
+#endif
+}
+
+inline float FastMath::sqrt(float x) {
+  return x > 0.0f ? x * rsqrt(x) : 0.0f;
+}
+
+inline void FastMath::sincos(const float* x, float* s, float* c, size_t count) {
+  size_t i = 0;
+#ifdef BELLUM_SIMD_SSE
+  for (; i + 4 <= count; i += 4) {
+    __m128 vs, vc;
+    sincos4(_mm_loadu_ps(x + i), vs, vc);
+    _mm_storeu_ps(s + i, vs);
+    _mm_storeu_ps(c + i, vc);
+  }
+#endif
+  for (; i < count; i++) {
+    sincos(x[i], s[i], c[i]);
+  }
+}
+
+#ifdef BELLUM_SIMD_SSE
+
+inline void FastMath::sincos4(__m128 x, __m128& s, __m128& c) {
+  // same steps as the scalar version, the quadrant swap and signs become masks
+  __m128 qf = _mm_mul_ps(x, _mm_set1_ps(k2OverPi));
+  __m128 half = _mm_or_ps(_mm_and_ps(qf, _mm_set1_ps(-0.0f)), _mm_set1_ps(0.5f));
+  __m128i q = _mm_cvttps_epi32(_mm_add_ps(qf, half));
+  __m128 fq = _mm_cvtepi32_ps(q);
+  __m128 r = _mm_sub_ps(x, _mm_mul_ps(fq, _mm_set1_ps(kPiOver2A)));
+  r = _mm_sub_ps(r, _mm_mul_ps(fq, _mm_set1_ps(kPiOver2B)));
+  r = _mm_sub_ps(r, _mm_mul_ps(fq, _mm_set1_ps(kPiOver2C)));
+
+  __m128 r2 = _mm_mul_ps(r, r);
+  __m128 ps = _mm_add_ps(_mm_set1_ps(kSin2), _mm_mul_ps(r2, _mm_set1_ps(kSin3)));
+  ps = _mm_add_ps(_mm_set1_ps(kSin1), _mm_mul_ps(r2, ps));
+  ps = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, r2), ps));
+
+  __m128 pc = _mm_add_ps(_mm_set1_ps(kCos2), _mm_mul_ps(r2, _mm_set1_ps(kCos3)));
+  pc = _mm_add_ps(_mm_set1_ps(kCos1), _mm_mul_ps(r2, pc));
+  pc = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_set1_ps(0.5f), r2)),
+                  _mm_mul_ps(_mm_mul_ps(r2, r2), pc));
+
+  __m128i one = _mm_set1_epi32(1);
+  __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(q, one), one));
+  __m128 signS = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(q, _mm_set1_epi32(2)), 30));
+  __m128 signC = _mm_castsi128_ps(
+    _mm_slli_epi32(_mm_and_si128(_mm_add_epi32(q, one), _mm_set1_epi32(2)), 30));
+
+  s = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, pc), _mm_andnot_ps(swap, ps)), signS);
+  c = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, ps), _mm_andnot_ps(swap, pc)), signC);
+}
+
+inline __m128 FastMath::rsqrt4(__m128 x) {
+  // 12 bit hardware estimate refined by one Newton step
+  __m128 y = _mm_rsqrt_ps(x);
+  __m128 xyy = _mm_mul_ps(_mm_mul_ps(x, y), y);
+  return _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), y), _mm_sub_ps(_mm_set1_ps(3.0f), xyy));
+}
+
+#endif
+
+}
+
+#endif
@@ -0,0 +1,54 @@
+#include "math.h"
+#include "vector2.h"
+#include "vector3.h"
+#include "vector4.h"
+#include "quaternion.h"
+#include "matrix4.h"
+#include "affine3.h"
+#include "../color.h"
+
+namespace bellum {
+
+// The constexpr parts of the math types are only useful if they really fold, every check below
+// fails to compile if one of them stops being a constant expression.
+namespace {
+
+constexpr Vector3 kDiagonal = Vector3::right() + Vector3::up() + Vector3::forward();
+static_assert(kDiagonal == Vector3::one(), "basis vectors");
+static_assert(Vector3::cross(Vector3::right(), Vector3::up()) == Vector3::forward(), "cross");
+static_assert(Vector3::dot(kDiagonal, Vector3{1.0f, 2.0f, 3.0f}) == 6.0f, "dot");
+static_assert(-Vector3::up() == Vector3::down() && -Vector3::forward() == Vector3::back(),
+              "negation");
+static_assert(2.0f * Vector3{1.0f, 2.0f, 3.0f} == Vector3{2.0f, 4.0f, 6.0f}, "scalar product");
+static_assert(Vector3::lerp(Vector3::zero(), kDiagonal, 2.0f) == kDiagonal, "lerp");
+static_assert(Vector3::scale(kDiagonal * 2.0f, Vector3{1.0f, 0.5f, 0.0f}) ==
+              Vector3{2.0f, 1.0f, 0.0f}, "scale");
+
+static_assert(Vector2{1.0f, 2.0f} * 2.0f - Vector2{1.0f, 1.0f} == Vector2{1.0f, 3.0f},
+              "Vector2 arithmetic");
+static_assert(Vector4::dot(Vector4::one(), Vector4{1.0f, 2.0f, 3.0f, 4.0f}) == 10.0f,
+              "Vector4 dot");
+
+static_assert(Quaternion::dot(Quaternion::identity()) == 1.0f, "identity");
+static_assert(Quaternion::identity().conjugated().w == 1.0f, "conjugate");
+
+constexpr Matrix4 kTranslation = Matrix4::makeTranslation(1.0f, 2.0f, 3.0f);
+static_assert(kTranslation.get(0, 3) == 1.0f && kTranslation.get(2, 3) == 3.0f, "translation");
+static_assert(Matrix4::makeScale(2.0f, 3.0f, 4.0f).determinant() == 24.0f, "scale");
+static_assert(Matrix4::makeRotation(Quaternion::identity()).determinant() == 1.0f, "rotation");
+static_assert((Matrix4::identity() * 2.0f - Matrix4::identity()).get(3, 3) == 1.0f,
+              "Matrix4 arithmetic");
+static_assert(Matrix4::makeOrthographic(-1.0f, 1.0f, -1.0f, 1.0f, 0.0f, 1.0f).get(2, 2) == -1.0f,
+              "orthographic");
+
+static_assert(Affine3::multiplyPoint(Affine3::makeTranslation(kDiagonal), kDiagonal) ==
+              kDiagonal * 2.0f, "affine point");
+static_assert(Affine3::makeScale(kDiagonal * 2.0f).toMatrix4().determinant() == 8.0f,
+              "affine to matrix");
+
+static_assert(Color::white().r == 1.0f && Color::clear().a == 0.0f, "colors");
+static_assert(Color{0xFF0000FFu}.r == 1.0f && Color{0xFF0000FFu}.b == 0.0f, "packed color");
+
+}
+
+}
@@ -3,6 +3,7 @@
 
 #include "../common.h"
 #include <cmath>
+#include "fast_math.h"
 
 namespace bellum {
 
@@ -15,11 +16,11 @@ public:
   static constexpr float kRadToDeg = 180.0f / kPi;
   static constexpr float kDegToRad = kPi / 180.0f;
 
-  static inline float rad(float deg) {
+  static inline constexpr float rad(float deg) {
     return deg * kDegToRad;
   }
 
-  static inline float deg(float rad) {
+  static inline constexpr float deg(float rad) {
     return rad * kRadToDeg;
   }
 
@@ -27,6 +28,10 @@ public:
     return std::sqrt(x);
   }
 
+  static inline float rsqrt(float x) {
+    return 1.0f / std::sqrt(x);
+  }
+
   static inline float pow(float x, float y) {
     return std::pow(x, y);
   }
@@ -43,6 +48,11 @@ public:
     return std::cos(x);
   }
 
+  static inline void sincos(float x, float& s, float& c) {
+    s = std::sin(x);
+    c = std::cos(x);
+  }
+
   static inline float acos(float x) {
     return std::acos(x);
   }
@@ -59,19 +69,19 @@ public:
     return std::atan2(y, x);
   }
 
-  static inline float abs(float x) {
+  static inline constexpr float abs(float x) {
     return x < 0.0f ? -x : x;
   }
 
-  static inline float max(float a, float b) {
+  static inline constexpr float max(float a, float b) {
     return a < b ? b : a;
   }
 
-  static inline float min(float a, float b) {
+  static inline constexpr float min(float a, float b) {
     return a < b ? a : b;
   }
 
-  static inline float clamp(float x, float min, float max) {
+  static inline constexpr float clamp(float x, float min, float max) {
     return x < min ? min : x > max ? max : x;
   }
 
@@ -87,13 +97,54 @@ public:
     return static_cast<int32>(std::round(x));
   }
 
-  static inline float sign(float x) {
+  static inline constexpr float sign(float x) {
     return x < 0.0f ? -1.0f : x > 0.0f ? 1.0f : 0.0f;
   }
 
-  static inline float lerp(float a, float b, float t) {
+  static inline constexpr float lerp(float a, float b, float t) {
     return a + (b - a) * t;
   }
+
+  // Tiered versions, Math::sin<Precision::FAST>(x) uses the FastMath approximation and
+  // Precision::PRECISE the function above
+  template<Precision P>
+  static inline float sqrt(float x) {
+    return P == Precision::FAST ? FastMath::sqrt(x) : sqrt(x);
+  }
+
+  template<Precision P>
+  static inline float rsqrt(float x) {
+    return P == Precision::FAST ? FastMath::rsqrt(x) : rsqrt(x);
+  }
+
+  template<Precision P>
+  static inline float sin(float x) {
+    return P == Precision::FAST ? FastMath::sin(x) : sin(x);
+  }
+
+  template<Precision P>
+  static inline float cos(float x) {
+    return P == Precision::FAST ? FastMath::cos(x) : cos(x);
+  }
+
+  template<Precision P>
+  static inline void sincos(float x, float& s, float& c) {
+    if (P == Precision::FAST) {
+      FastMath::sincos(x, s, c);
+    } else {
+      sincos(x, s, c);
+    }
+  }
+
+  template<Precision P>
+  static inline float acos(float x) {
+    return P == Precision::FAST ? FastMath::acos(x) : acos(x);
+  }
+
+  template<Precision P>
+  static inline float atan2(float y, float x) {
+    return P == Precision::FAST ? FastMath::atan2(y, x) : atan2(y, x);
+  }
 };
 
 }
@@ -9,23 +9,25 @@
 #include "vector4.h"
 #include "quaternion.h"
 #include "plane.h"
+#include "simd.h"
 
 namespace bellum {
 
-struct Matrix4 {
+// Column-major, data[column * 4 + row]
+struct BELLUM_MATH_ALIGN Matrix4 {
   std::array<float, 16> data;
 
-  inline float get(int32 row, int32 column) const;
+  inline constexpr float get(int32 row, int32 column) const;
   inline void set(int32 row, int32 column, float value);
   inline void set(int32 i, float value);
   inline float& operator[](size_t i);
-  inline const float& operator[](size_t i) const;
+  inline constexpr const float& operator[](size_t i) const;
   inline void clear();
   inline void setTransformation(const Vector3& translation,
                                 const Quaternion& rotation,
                                 const Vector3& scale);
 
-  inline float determinant() const;
+  inline constexpr float determinant() const;
   inline Matrix4& inverse();
   inline Matrix4 inversed() const;
   inline Matrix4& negate();
@@ -41,23 +43,23 @@ struct Matrix4 {
   inline static Vector3 multiplyVector(const Matrix4& m, const Vector4& v);
   inline static Vector4 multiplyVector4(const Matrix4& m, const Vector4& v);
 
-  inline Matrix4 operator+(const Matrix4& m) const;
-  inline Matrix4 operator-(const Matrix4& m) const;
+  inline constexpr Matrix4 operator+(const Matrix4& m) const;
+  inline constexpr Matrix4 operator-(const Matrix4& m) const;
   inline Matrix4& operator+=(const Matrix4& m);
   inline Matrix4& operator-=(const Matrix4& m);
-  inline Matrix4 operator-() const;
+  inline constexpr Matrix4 operator-() const;
   inline Matrix4 operator*(const Matrix4& m) const;
   inline Matrix4& operator*=(const Matrix4& m);
-  inline Matrix4 operator+(float a) const;
+  inline constexpr Matrix4 operator+(float a) const;
   inline Matrix4& operator+=(float a);
-  inline Matrix4 operator-(float a) const;
+  inline constexpr Matrix4 operator-(float a) const;
   inline Matrix4& operator-=(float a);
-  inline Matrix4 operator*(float a) const;
+  inline constexpr Matrix4 operator*(float a) const;
   inline Matrix4& operator*=(float a);
-  inline Matrix4 operator/(float a) const;
+  inline constexpr Matrix4 operator/(float a) const;
   inline Matrix4& operator/=(float a);
 
-  inline static Matrix4 makeOrthographic(float left, float right,
+  inline static constexpr Matrix4 makeOrthographic(float left, float right,
                                          float bottom, float top,
                                          float near, float far);
   inline static Matrix4 makePerspective(float fov, float aspect, float near, float far);
@@ -72,15 +74,15 @@ struct Matrix4 {
                                       const Vector3& cameraUp,
                                       const Vector3& cameraForward);
   inline static Matrix4 makeReflection(const Plane& plane);
-  inline static Matrix4 makeTranslation(const Vector3& translation);
-  inline static Matrix4 makeTranslation(float x, float y, float z);
-  inline static Matrix4 makeScale(const Vector3& scale);
-  inline static Matrix4 makeScale(float x, float y, float z);
-  inline static Matrix4 makeRotation(const Vector3& forward,
+  inline static constexpr Matrix4 makeTranslation(const Vector3& translation);
+  inline static constexpr Matrix4 makeTranslation(float x, float y, float z);
+  inline static constexpr Matrix4 makeScale(const Vector3& scale);
+  inline static constexpr Matrix4 makeScale(float x, float y, float z);
+  inline static constexpr Matrix4 makeRotation(const Vector3& forward,
                                      const Vector3& up,
                                      const Vector3& right);
   inline static Matrix4 makeRotation(const Vector3& forward, const Vector3& up);
-  inline static Matrix4 makeRotation(const Quaternion& q);
+  inline static constexpr Matrix4 makeRotation(const Quaternion& q);
   inline static Matrix4 makeAxisRotation(const Vector3& axis, float angle);
   inline static Matrix4 makeEulerRotation(const Vector3& euler);
   inline static Matrix4 makeEulerRotation(float x, float y, float z);
@@ -88,13 +90,13 @@ struct Matrix4 {
   inline static Matrix4 makeRotationAroundY(float angle);
   inline static Matrix4 makeRotationAroundZ(float angle);
 
-  inline static const Matrix4& identity();
-  inline static const Matrix4& zero();
+  inline static constexpr Matrix4 identity();
+  inline static constexpr Matrix4 zero();
 
   friend std::ostream& operator<<(std::ostream& os, const Matrix4& m);
 };
 
-inline float Matrix4::get(int32 row, int32 column) const {
+inline constexpr float Matrix4::get(int32 row, int32 column) const {
   return data[(column << 2) + row];
 }
 
@@ -110,7 +112,7 @@ inline float& Matrix4::operator[](size_t i) {
   return data[i];
 }
 
-inline const float& Matrix4::operator[](size_t i) const {
+inline constexpr const float& Matrix4::operator[](size_t i) const {
   return data[i];
 }
 
@@ -125,7 +127,7 @@ inline void Matrix4::setTransformation(const Vector3& translation,
 }
 
 // Algebra
-inline float Matrix4::determinant() const {
+inline constexpr float Matrix4::determinant() const {
   float a0 = data[0] * data[5] - data[1] * data[4];
   float a1 = data[0] * data[6] - data[2] * data[4];
   float a2 = data[0] * data[7] - data[3] * data[4];
@@ -148,6 +150,68 @@ inline Matrix4& Matrix4::inverse() {
 }
 
 inline Matrix4 Matrix4::inversed() const {
+#ifdef BELLUM_SIMD_SSE
+  // Block-wise inverse over 2x2 sub-matrices. Columns are treated as rows, which inverts the
+  // transpose, and storing the result the same way transposes it back.
+  __m128 c0 = simd::load(&data[0]);
+  __m128 c1 = simd::load(&data[4]);
+  __m128 c2 = simd::load(&data[8]);
+  __m128 c3 = simd::load(&data[12]);
+
+  __m128 a = _mm_movelh_ps(c0, c1);
+  __m128 b = _mm_movehl_ps(c1, c0);
+  __m128 c = _mm_movelh_ps(c2, c3);
+  __m128 d = _mm_movehl_ps(c3, c2);
+
+  // 2x2 products of row-major blocks: m * n, adj(m) * n and m * adj(n)
+  auto mul = [](__m128 m, __m128 n) {
+    return _mm_add_ps(_mm_mul_ps(m, simd::swizzle<0, 3, 0, 3>(n)),
+                      _mm_mul_ps(simd::swizzle<1, 0, 3, 2>(m), simd::swizzle<2, 1, 2, 1>(n)));
+  };
+  auto adjMul = [](__m128 m, __m128 n) {
+    return _mm_sub_ps(_mm_mul_ps(simd::swizzle<3, 3, 0, 0>(m), n),
+                      _mm_mul_ps(simd::swizzle<1, 1, 2, 2>(m), simd::swizzle<2, 3, 0, 1>(n)));
+  };
+  auto mulAdj = [](__m128 m, __m128 n) {
+    return _mm_sub_ps(_mm_mul_ps(m, simd::swizzle<3, 0, 3, 0>(n)),
+                      _mm_mul_ps(simd::swizzle<1, 0, 3, 2>(m), simd::swizzle<2, 1, 2, 1>(n)));
+  };
+
+  // determinants of the blocks as (|a|, |b|, |c|, |d|)
+  __m128 detSub = _mm_sub_ps(
+    _mm_mul_ps(simd::shuffle<0, 2, 0, 2>(c0, c2), simd::shuffle<1, 3, 1, 3>(c1, c3)),
+    _mm_mul_ps(simd::shuffle<1, 3, 1, 3>(c0, c2), simd::shuffle<0, 2, 0, 2>(c1, c3)));
+  __m128 detA = simd::splat<0>(detSub);
+  __m128 detB = simd::splat<1>(detSub);
+  __m128 detC = simd::splat<2>(detSub);
+  __m128 detD = simd::splat<3>(detSub);
+
+  __m128 dc = adjMul(d, c);
+  __m128 ab = adjMul(a, b);
+  __m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), mul(b, dc));
+  __m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), mul(c, ab));
+  __m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), mulAdj(d, ab));
+  __m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), mulAdj(a, dc));
+
+  // |m| = |a||d| + |b||c| - tr(adj(a) b adj(d) c)
+  __m128 tr = _mm_mul_ps(ab, simd::swizzle<0, 2, 1, 3>(dc));
+  tr = _mm_add_ps(tr, _mm_movehl_ps(tr, tr));
+  tr = simd::splat<0>(_mm_add_ps(tr, simd::splat<1>(tr)));
+  __m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), tr);
+
+  __m128 scale = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
+  x = _mm_mul_ps(x, scale);
+  y = _mm_mul_ps(y, scale);
+  z = _mm_mul_ps(z, scale);
+  w = _mm_mul_ps(w, scale);
+
+  Matrix4 inverse;
+  simd::store(&inverse.data[0], simd::shuffle<3, 1, 3, 1>(x, y));
+  simd::store(&inverse.data[4], simd::shuffle<2, 0, 2, 0>(x, y));
+  simd::store(&inverse.data[8], simd::shuffle<3, 1, 3, 1>(z, w));
+  simd::store(&inverse.data[12], simd::shuffle<2, 0, 2, 0>(z, w));
+  return inverse;
+#else
   float a0 = data[0] * data[5] - data[1] * data[4];
   float a1 = data[0] * data[6] - data[2] * data[4];
   float a2 = data[0] * data[7] - data[3] * data[4];
@@ -185,6 +249,7 @@ inline Matrix4 Matrix4::inversed() const {
   inverse[15] = data[8] * a3 - data[9] * a1 + data[10] * a0;
 
   return inverse / d;
+#endif
 }
 
 inline Matrix4& Matrix4::negate() {
@@ -204,6 +269,7 @@ inline Matrix4& Matrix4::negate() {
   data[13] = -data[13];
   data[14] = -data[14];
   data[15] = -data[15];
+  return *this;
 }
 
 inline Matrix4 Matrix4::negated() const {
@@ -212,6 +278,17 @@ inline Matrix4 Matrix4::negated() const {
 }
 
 inline Matrix4& Matrix4::transpose() {
+#ifdef BELLUM_SIMD_SSE
+  __m128 c0 = simd::load(&data[0]);
+  __m128 c1 = simd::load(&data[4]);
+  __m128 c2 = simd::load(&data[8]);
+  __m128 c3 = simd::load(&data[12]);
+  _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+  simd::store(&data[0], c0);
+  simd::store(&data[4], c1);
+  simd::store(&data[8], c2);
+  simd::store(&data[12], c3);
+#else
   std::array<float, 16> t = {
     data[0], data[4], data[8], data[12],
     data[1], data[5], data[9], data[13],
@@ -219,6 +296,8 @@ inline Matrix4& Matrix4::transpose() {
     data[3], data[7], data[11], data[15]
   };
   data = t;
+#endif
+  return *this;
 }
 
 inline Matrix4 Matrix4::transposed() const {
@@ -243,24 +322,40 @@ inline Vector3 Matrix4::multiplyVector(const Matrix4& m, const Vector3& v) {
 }
 
 inline Vector3 Matrix4::multiplyVector(const Matrix4& m, const Vector4& v) {
+#ifdef BELLUM_SIMD_SSE
+  Vector4 r = multiplyVector4(m, v);
+  return {r.x, r.y, r.z};
+#else
   return {
     v.x * m[0] + v.y * m[4] + v.z * m[8] + v.w * m[12],
     v.x * m[1] + v.y * m[5] + v.z * m[9] + v.w * m[13],
     v.x * m[2] + v.y * m[6] + v.z * m[10] + v.w * m[14]
   };
+#endif
 }
 
 inline Vector4 Matrix4::multiplyVector4(const Matrix4& m, const Vector4& v) {
+#ifdef BELLUM_SIMD_SSE
+  __m128 r = simd::combine(simd::load(&m.data[0]),
+                           simd::load(&m.data[4]),
+                           simd::load(&m.data[8]),
+                           simd::load(&m.data[12]),
+                           _mm_setr_ps(v.x, v.y, v.z, v.w));
+  Vector4 result;
+  _mm_storeu_ps(&result.x, r);
+  return result;
+#else
   return {
     v.x * m[0] + v.y * m[4] + v.z * m[8] + v.w * m[12],
     v.x * m[1] + v.y * m[5] + v.z * m[9] + v.w * m[13],
     v.x * m[2] + v.y * m[6] + v.z * m[10] + v.w * m[14],
     v.x * m[3] + v.y * m[7] + v.z * m[11] + v.w * m[15]
   };
+#endif
 }
 
 // Operators
-inline Matrix4 Matrix4::operator+(const Matrix4& m) const {
+inline constexpr Matrix4 Matrix4::operator+(const Matrix4& m) const {
   return {
     m.data[0] + data[0],
     m.data[1] + data[1],
@@ -281,24 +376,24 @@ inline Matrix4 Matrix4::operator+(const Matrix4& m) const {
   };
 }
 
-inline Matrix4 Matrix4::operator-(const Matrix4& m) const {
+inline constexpr Matrix4 Matrix4::operator-(const Matrix4& m) const {
   return {
-    m.data[0] - data[0],
-    m.data[1] - data[1],
-    m.data[2] - data[2],
-    m.data[3] - data[3],
-    m.data[4] - data[4],
-    m.data[5] - data[5],
-    m.data[6] - data[6],
-    m.data[7] - data[7],
-    m.data[8] - data[8],
-    m.data[9] - data[9],
-    m.data[10] - data[10],
-    m.data[11] - data[11],
-    m.data[12] - data[12],
-    m.data[13] - data[13],
-    m.data[14] - data[14],
-    m.data[15] - data[15]
+    data[0] - m.data[0],
+    data[1] - m.data[1],
+    data[2] - m.data[2],
+    data[3] - m.data[3],
+    data[4] - m.data[4],
+    data[5] - m.data[5],
+    data[6] - m.data[6],
+    data[7] - m.data[7],
+    data[8] - m.data[8],
+    data[9] - m.data[9],
+    data[10] - m.data[10],
+    data[11] - m.data[11],
+    data[12] - m.data[12],
+    data[13] - m.data[13],
+    data[14] - m.data[14],
+    data[15] - m.data[15]
   };
 }
 
@@ -312,11 +407,24 @@ inline Matrix4& Matrix4::operator-=(const Matrix4& m) {
   return *this;
 }
 
-inline Matrix4 Matrix4::operator-() const {
-  return negated();
+inline constexpr Matrix4 Matrix4::operator-() const {
+  return *this * -1.0f;
 }
 
 inline Matrix4 Matrix4::operator*(const Matrix4& m) const {
+#ifdef BELLUM_SIMD_SSE
+  // each result column is this matrix applied to a column of m
+  __m128 c0 = simd::load(&data[0]);
+  __m128 c1 = simd::load(&data[4]);
+  __m128 c2 = simd::load(&data[8]);
+  __m128 c3 = simd::load(&data[12]);
+
+  Matrix4 result;
+  for (int32 i = 0; i < 16; i += 4) {
+    simd::store(&result.data[i], simd::combine(c0, c1, c2, c3, simd::load(&m.data[i])));
+  }
+  return result;
+#else
   return {
     data[0] * m.data[0] + data[4] * m.data[1] + data[8] * m.data[2] + data[12] * m.data[3],
     data[1] * m.data[0] + data[5] * m.data[1] + data[9] * m.data[2] + data[13] * m.data[3],
@@ -335,6 +443,7 @@ inline Matrix4 Matrix4::operator*(const Matrix4& m) const {
     data[2] * m.data[12] + data[6] * m.data[13] + data[10] * m.data[14] + data[14] * m.data[15],
     data[3] * m.data[12] + data[7] * m.data[13] + data[11] * m.data[14] + data[15] * m.data[15]
   };
+#endif
 }
 
 inline Matrix4& Matrix4::operator*=(const Matrix4& m) {
@@ -342,7 +451,7 @@ inline Matrix4& Matrix4::operator*=(const Matrix4& m) {
   return *this;
 }
 
-inline Matrix4 Matrix4::operator+(float a) const {
+inline constexpr Matrix4 Matrix4::operator+(float a) const {
   return {
     data[0] + a,
     data[1] + a,
@@ -368,7 +477,7 @@ inline Matrix4& Matrix4::operator+=(float a) {
   return *this;
 }
 
-inline Matrix4 Matrix4::operator-(float a) const {
+inline constexpr Matrix4 Matrix4::operator-(float a) const {
   return {
     data[0] - a,
     data[1] - a,
@@ -394,7 +503,7 @@ inline Matrix4& Matrix4::operator-=(float a) {
   return *this;
 }
 
-inline Matrix4 Matrix4::operator*(float a) const {
+inline constexpr Matrix4 Matrix4::operator*(float a) const {
   return {
     data[0] * a,
     data[1] * a,
@@ -420,7 +529,7 @@ inline Matrix4& Matrix4::operator*=(float a) {
   return *this;
 }
 
-inline Matrix4 Matrix4::operator/(float a) const {
+inline constexpr Matrix4 Matrix4::operator/(float a) const {
   return {
     data[0] / a,
     data[1] / a,
@@ -451,18 +560,15 @@ inline Vector3 operator*(const Matrix4& m, const Vector3& v) {
 }
 
 // Factory methods
-inline Matrix4 Matrix4::makeOrthographic(float left, float right,
+inline constexpr Matrix4 Matrix4::makeOrthographic(float left, float right,
                                          float bottom, float top,
                                          float near, float far) {
-  Matrix4 result{};
-  result[0] = 2.0f / (right - left);
-  result[5] = 2.0f / (top - bottom);
-  result[12] = (left + right) / (left - right);
-  result[10] = 1.0f / (near - far);
-  result[13] = (top + bottom) / (bottom - top);
-  result[14] = near / (near - far);
-  result[15] = 1.0f;
-  return result;
+  return {
+    2.0f / (right - left), 0.0f, 0.0f, 0.0f,
+    0.0f, 2.0f / (top - bottom), 0.0f, 0.0f,
+    0.0f, 0.0f, 1.0f / (near - far), 0.0f,
+    (left + right) / (left - right), (top + bottom) / (bottom - top), near / (near - far), 1.0f
+  };
 }
 
 inline Matrix4 Matrix4::makePerspective(float fov, float aspect, float near, float far) {
@@ -492,7 +598,17 @@ inline Matrix4 Matrix4::makePerspective(float fov, float aspect, float near, flo
 inline Matrix4 Matrix4::makeTransformation(const Vector3& translation,
                                            const Quaternion& rotation,
                                            const Vector3& scale) {
-  return makeTranslation(translation) * makeRotation(rotation) * makeScale(scale);
+  // same as translation * rotation * scale without the two general products
+  Matrix4 result = makeRotation(rotation);
+  for (int32 i = 0; i < 3; i++) {
+    result[i] *= scale.x;
+    result[4 + i] *= scale.y;
+    result[8 + i] *= scale.z;
+  }
+  result[12] = translation.x;
+  result[13] = translation.y;
+  result[14] = translation.z;
+  return result;
 }
 
 inline Matrix4 Matrix4::makeLookAt(const Vector3& position,
@@ -565,31 +681,33 @@ inline Matrix4 Matrix4::makeReflection(const Plane& plane) {
   return result;
 }
 
-inline Matrix4 Matrix4::makeTranslation(const Vector3& translation) {
+inline constexpr Matrix4 Matrix4::makeTranslation(const Vector3& translation) {
   return makeTranslation(translation.x, translation.y, translation.z);
 }
 
-inline Matrix4 Matrix4::makeTranslation(float x, float y, float z) {
-  Matrix4 result = identity();
-  result[12] = x;
-  result[13] = y;
-  result[14] = z;
-  return result;
+inline constexpr Matrix4 Matrix4::makeTranslation(float x, float y, float z) {
+  return {
+    1.0f, 0.0f, 0.0f, 0.0f,
+    0.0f, 1.0f, 0.0f, 0.0f,
+    0.0f, 0.0f, 1.0f, 0.0f,
+    x, y, z, 1.0f
+  };
 }
 
-inline Matrix4 Matrix4::makeScale(const Vector3& scale) {
+inline constexpr Matrix4 Matrix4::makeScale(const Vector3& scale) {
   return makeScale(scale.x, scale.y, scale.z);
 }
 
-inline Matrix4 Matrix4::makeScale(float x, float y, float z) {
-  Matrix4 result = identity();
-  result[0] = x;
-  result[5] = y;
-  result[10] = z;
-  return result;
+inline constexpr Matrix4 Matrix4::makeScale(float x, float y, float z) {
+  return {
+    x, 0.0f, 0.0f, 0.0f,
+    0.0f, y, 0.0f, 0.0f,
+    0.0f, 0.0f, z, 0.0f,
+    0.0f, 0.0f, 0.0f, 1.0f
+  };
 }
 
-inline Matrix4 Matrix4::makeRotation(const Vector3& forward,
+inline constexpr Matrix4 Matrix4::makeRotation(const Vector3& forward,
                                      const Vector3& up,
                                      const Vector3& right) {
   return {
@@ -620,7 +738,7 @@ inline Matrix4 Matrix4::makeRotation(const Vector3& forward, const Vector3& up)
   return makeRotation(f, u, r);
 }
 
-inline Matrix4 Matrix4::makeRotation(const Quaternion& q) {
+inline constexpr Matrix4 Matrix4::makeRotation(const Quaternion& q) {
   float x2 = q.x + q.x;
   float y2 = q.y + q.y;
   float z2 = q.z + q.z;
@@ -635,27 +753,12 @@ inline Matrix4 Matrix4::makeRotation(const Quaternion& q) {
   float wy2 = q.w * y2;
   float wz2 = q.w * z2;
 
-  Matrix4 result;
-  result[0] = 1.0f - yy2 - zz2;
-  result[1] = xy2 + wz2;
-  result[2] = xz2 - wy2;
-  result[3] = 0.0f;
-
-  result[4] = xy2 - wz2;
-  result[5] = 1.0f - xx2 - zz2;
-  result[6] = yz2 + wx2;
-  result[7] = 0.0f;
-
-  result[8] = xz2 + wy2;
-  result[9] = yz2 - wx2;
-  result[10] = 1.0f - xx2 - yy2;
-  result[11] = 0.0f;
-
-  result[12] = 0.0f;
-  result[13] = 0.0f;
-  result[14] = 0.0f;
-  result[15] = 1.0f;
-  return result;
+  return {
+    1.0f - yy2 - zz2, xy2 + wz2, xz2 - wy2, 0.0f,
+    xy2 - wz2, 1.0f - xx2 - zz2, yz2 + wx2, 0.0f,
+    xz2 + wy2, yz2 - wx2, 1.0f - xx2 - yy2, 0.0f,
+    0.0f, 0.0f, 0.0f, 1.0f
+  };
 }
 
 inline Matrix4 Matrix4::makeAxisRotation(const Vector3& axis, float angle) {
@@ -760,24 +863,22 @@ inline Matrix4 Matrix4::makeRotationAroundZ(float angle) {
   return result;
 }
 
-inline const Matrix4& Matrix4::identity() {
-  static const Matrix4 value{
+inline constexpr Matrix4 Matrix4::identity() {
+  return {
     1.0f, 0.0f, 0.0f, 0.0f,
     0.0f, 1.0f, 0.0f, 0.0f,
     0.0f, 0.0f, 1.0f, 0.0f,
     0.0f, 0.0f, 0.0f, 1.0f
   };
-  return value;
 }
 
-inline const Matrix4& Matrix4::zero() {
-  static const Matrix4 value{
+inline constexpr Matrix4 Matrix4::zero() {
+  return {
     0.0f, 0.0f, 0.0f, 0.0f,
     0.0f, 0.0f, 0.0f, 0.0f,
     0.0f, 0.0f, 0.0f, 0.0f,
     0.0f, 0.0f, 0.0f, 0.0f
   };
-  return value;
 }
 
 inline std::ostream& operator<<(std::ostream& os, const Matrix4& m) {
@@ -794,6 +895,15 @@ inline std::ostream& operator<<(std::ostream& os, const Matrix4& m) {
   return os;
 }
 
+inline void formatValue(FormatBuffer& out, const Matrix4& m) {
+  out << "Matrix4(\n";
+  for (int32 row = 0; row < 4; row++) {
+    out << ' ' << m.get(row, 0) << ", " << m.get(row, 1) << ", " << m.get(row, 2) << ", "
+        << m.get(row, 3) << ",\n";
+  }
+  out << ')';
+}
+
 }
 
 #endif
@@ -5,13 +5,14 @@
 #include "../common.h"
 #include "math.h"
 #include "vector3.h"
+#include "simd.h"
 
 namespace bellum {
 
 struct Vector3;
 struct Matrix4;
 
-struct Quaternion {
+struct BELLUM_MATH_ALIGN Quaternion {
   float x, y, z, w;
 
   inline Quaternion operator*(const Quaternion& q) const;
@@ -19,65 +20,96 @@ struct Quaternion {
 
   inline Vector3 eulerAngles() const;
   inline float magnitude() const;
-  inline float squaredMagnitude() const;
+  inline constexpr float squaredMagnitude() const;
+  template<Precision P = Precision::PRECISE>
   inline Quaternion& normalize();
+  template<Precision P = Precision::PRECISE>
   inline Quaternion normalized() const;
-  inline Quaternion& conjugate();
-  inline Quaternion conjugated() const;
+  inline constexpr Quaternion& conjugate();
+  inline constexpr Quaternion conjugated() const;
   inline Quaternion& inverse();
   inline Quaternion inversed() const;
 
   inline static float angle(const Quaternion& a, const Quaternion& b);
+  template<Precision P = Precision::PRECISE>
   inline static Quaternion makeAngleAxis(float angle, const Vector3& axis);
-  inline static float dot(const Quaternion& q);
-  inline static float dot(const Quaternion& a, const Quaternion& b);
+  inline static constexpr float dot(const Quaternion& q);
+  inline static constexpr float dot(const Quaternion& a, const Quaternion& b);
+  template<Precision P = Precision::PRECISE>
   inline static Quaternion makeEuler(const Vector3& euler);
+  template<Precision P = Precision::PRECISE>
   inline static Quaternion makeEuler(float x, float y, float z);
   inline static Quaternion makeFromToRotation(const Vector3& from, const Vector3& to);
   static Quaternion makeFromMatrix(const Matrix4& m);
-  inline static Quaternion lerp(const Quaternion& a, const Quaternion& b, float t);
-  inline static Quaternion lerpUnclamped(const Quaternion& a, const Quaternion& b, float t);
+  inline static constexpr Quaternion lerp(const Quaternion& a, const Quaternion& b, float t);
+  inline static constexpr Quaternion lerpUnclamped(const Quaternion& a, const Quaternion& b,
+                                                   float t);
   inline static Quaternion makeLookRotation(const Vector3& forward, const Vector3& upwards);
   inline static Quaternion rotateTowards(const Quaternion& from, const Quaternion& to, float delta);
   inline static Quaternion slerp(const Quaternion& a, const Quaternion& b, float t);
   inline static Quaternion slerpUnclamped(const Quaternion& a, const Quaternion& b, float t);
 
-  inline static const Quaternion& identity();
+  inline static constexpr Quaternion identity();
 
   friend std::ostream& operator<<(std::ostream& os, const Quaternion& q);
 };
 
 // Operators
 inline Quaternion Quaternion::operator*(const Quaternion& q) const {
+#ifdef BELLUM_SIMD_SSE
+  // every component of this quaternion scales a signed permutation of q
+  __m128 a = _mm_loadu_ps(&x);
+  __m128 b = _mm_loadu_ps(&q.x);
+  __m128 r = _mm_mul_ps(simd::splat<3>(a), b);
+  r = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(simd::splat<0>(a), simd::swizzle<3, 2, 1, 0>(b)),
+                               _mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f)));
+  r = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(simd::splat<1>(a), simd::swizzle<2, 3, 0, 1>(b)),
+                               _mm_setr_ps(1.0f, 1.0f, -1.0f, -1.0f)));
+  r = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(simd::splat<2>(a), simd::swizzle<1, 0, 3, 2>(b)),
+                               _mm_setr_ps(-1.0f, 1.0f, 1.0f, -1.0f)));
+  Quaternion result;
+  _mm_storeu_ps(&result.x, r);
+  return result;
+#else
   return {
     w * q.x + x * q.w + y * q.z - z * q.y,
     w * q.y + y * q.w + z * q.x - x * q.z,
     w * q.z + z * q.w + x * q.y - y * q.x,
     w * q.w - x * q.x - y * q.y - z * q.z
   };
+#endif
 }
 
 inline Quaternion& Quaternion::operator*=(const Quaternion& q) {
-  *this = {
-    w * q.x + x * q.w + y * q.z - z * q.y,
-    w * q.y - x * q.z + y * q.w + z * q.x,
-    w * q.z + x * q.y - y * q.x + z * q.w,
-    w * q.w - x * q.x - y * q.y - z * q.z
-  };
+  *this = *this * q;
   return *this;
 }
 
+// Rotates v by a unit quaternion as v + w t + q.xyz x t with t = 2 q.xyz x v, which is cheaper
+// than the two quaternion products of q v q*
 inline Vector3 operator*(const Quaternion& q, const Vector3& v) {
-  Quaternion conj = q.conjugated();
-  float nw = -q.x * v.x - q.y * v.y - q.z * v.z;
-  float nx = q.w * v.x + q.y * v.z - q.z * v.y;
-  float ny = q.w * v.y + q.z * v.x - q.x * v.z;
-  float nz = q.w * v.z + q.x * v.y - q.y * v.x;
-  Quaternion w{nx, ny, nz, nw};
-
-  w *= conj;
+#ifdef BELLUM_SIMD_SSE
+  __m128 qv = _mm_setr_ps(q.x, q.y, q.z, 0.0f);
+  __m128 p = _mm_setr_ps(v.x, v.y, v.z, 0.0f);
+  __m128 t = simd::cross(qv, p);
+  t = _mm_add_ps(t, t);
+  __m128 r = _mm_add_ps(p, _mm_mul_ps(_mm_set1_ps(q.w), t));
+  r = _mm_add_ps(r, simd::cross(qv, t));
+
+  alignas(16) float result[4];
+  _mm_store_ps(result, r);
+  return {result[0], result[1], result[2]};
+#else
+  float tx = 2.0f * (q.y * v.z - q.z * v.y);
+  float ty = 2.0f * (q.z * v.x - q.x * v.z);
+  float tz = 2.0f * (q.x * v.y - q.y * v.x);
 
-  return {w.x, w.y, w.z};
+  return {
+    v.x + q.w * tx + (q.y * tz - q.z * ty),
+    v.y + q.w * ty + (q.z * tx - q.x * tz),
+    v.z + q.w * tz + (q.x * ty - q.y * tx)
+  };
+#endif
 }
 
 // Properties
@@ -93,23 +125,28 @@ inline float Quaternion::magnitude() const {
   return Math::sqrt(x * x + y * y + z * z + w * w);
 }
 
-inline float Quaternion::squaredMagnitude() const {
+inline constexpr float Quaternion::squaredMagnitude() const {
   return x * x + y * y + z * z + w * w;
 }
 
+template<Precision P>
 inline Quaternion& Quaternion::normalize() {
-  float m = magnitude();
-
-  if (m != 0.0f) {
-    *this = {x / m, y / m, z / m, w / m};
-  } else {
-    *this = {0.0f, 0.0f, 0.0f, 1.0f};
-  }
-
+  *this = normalized<P>();
   return *this;
 }
 
+template<Precision P>
 inline Quaternion Quaternion::normalized() const {
+  if (P == Precision::FAST) {
+    float sm = squaredMagnitude();
+    if (sm == 0.0f) {
+      return identity();
+    }
+
+    float s = FastMath::rsqrt(sm);
+    return {x * s, y * s, z * s, w * s};
+  }
+
   float m = magnitude();
 
   if (m != 0.0f) {
@@ -121,12 +158,12 @@ inline Quaternion Quaternion::normalized() const {
   return *this;
 }
 
-inline Quaternion& Quaternion::conjugate() {
+inline constexpr Quaternion& Quaternion::conjugate() {
   *this = conjugated();
   return *this;
 }
 
-inline Quaternion Quaternion::conjugated() const {
+inline constexpr Quaternion Quaternion::conjugated() const {
   return {-x, -y, -z, w};
 }
 
@@ -145,7 +182,8 @@ float Quaternion::angle(const Quaternion& a, const Quaternion& b) {
   // TODO
 }
 
-Quaternion Quaternion::makeAngleAxis(float angle, const Vector3& axis) {
+template<Precision P>
+inline Quaternion Quaternion::makeAngleAxis(float angle, const Vector3& axis) {
   /*
   float ha = angle / 2.0f;
   float sin = Math::sin(ha);
@@ -153,27 +191,29 @@ Quaternion Quaternion::makeAngleAxis(float angle, const Vector3& axis) {
 
   return {n.x * sin, n.y * sin, n.z * sin, ha};
   */
-  float a = angle / 2.0f;
-  float s = Math::sin(a);
-  return {axis.x * s, axis.y * s, axis.z * s, Math::cos(a)};
+  float s, c;
+  Math::sincos<P>(angle / 2.0f, s, c);
+  return {axis.x * s, axis.y * s, axis.z * s, c};
 }
 
-inline float Quaternion::dot(const Quaternion& q) {
+inline constexpr float Quaternion::dot(const Quaternion& q) {
   return q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w;
 }
 
-inline float Quaternion::dot(const Quaternion& a, const Quaternion& b) {
+inline constexpr float Quaternion::dot(const Quaternion& a, const Quaternion& b) {
   return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
 }
 
+template<Precision P>
 inline Quaternion Quaternion::makeEuler(const Vector3& euler) {
-  return makeEuler(euler.x, euler.y, euler.z);
+  return makeEuler<P>(euler.x, euler.y, euler.z);
 }
 
+template<Precision P>
 inline Quaternion Quaternion::makeEuler(float x, float y, float z) {
-  Quaternion rx = makeAngleAxis(x, Vector3::right());
-  Quaternion ry = makeAngleAxis(y, Vector3::up());
-  Quaternion rz = makeAngleAxis(z, Vector3::back());
+  Quaternion rx = makeAngleAxis<P>(x, Vector3::right());
+  Quaternion ry = makeAngleAxis<P>(y, Vector3::up());
+  Quaternion rz = makeAngleAxis<P>(z, Vector3::back());
 
   return rz * ry * rx;
 }
@@ -182,11 +222,12 @@ inline Quaternion Quaternion::makeFromToRotation(const Vector3& from, const Vect
   // TODO
 }
 
-inline Quaternion Quaternion::lerp(const Quaternion& a, const Quaternion& b, float t) {
+inline constexpr Quaternion Quaternion::lerp(const Quaternion& a, const Quaternion& b, float t) {
   return lerpUnclamped(a, b, Math::clamp(t, 0.0f, 1.0f));
 }
 
-inline Quaternion Quaternion::lerpUnclamped(const Quaternion& a, const Quaternion& b, float t) {
+inline constexpr Quaternion Quaternion::lerpUnclamped(const Quaternion& a, const Quaternion& b,
+                                                      float t) {
   if (t == 0.0f) {
     return a;
   } else if (t == 1.0f) {
@@ -272,10 +313,9 @@ Quaternion Quaternion::slerpUnclamped(const Quaternion& a, const Quaternion& b,
   return {x * f1, y * f1, z * f1, w * f1};
 }
 
-// Singletons
-const Quaternion& Quaternion::identity() {
-  static Quaternion value{0.0f, 0.0f, 0.0f, 1.0f};
-  return value;
+// Constants
+inline constexpr Quaternion Quaternion::identity() {
+  return {0.0f, 0.0f, 0.0f, 1.0f};
 }
 
 inline std::ostream& operator<<(std::ostream& os, const Quaternion& q) {
@@ -283,6 +323,10 @@ inline std::ostream& operator<<(std::ostream& os, const Quaternion& q) {
   return os;
 }
 
+inline void formatValue(FormatBuffer& out, const Quaternion& q) {
+  out << "Quaternion(x: " << q.x << ", y: " << q.y << ", z: " << q.z << ", w: " << q.w << ')';
+}
+
 }
 
 #endif
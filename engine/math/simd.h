@@ -0,0 +1,77 @@
+#ifndef BELLUM_SIMD_H
+#define BELLUM_SIMD_H
+
+// SIMD kernels are selected at compile time: SSE whenever the target has SSE2 (always on x86-64),
+// scalar code otherwise or when BELLUM_NO_SIMD is defined. Both produce the same results within
+// float rounding.
+#if !defined(BELLUM_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define BELLUM_SIMD_SSE
+#include <emmintrin.h>
+#endif
+
+// Opt-in 16 byte alignment of Matrix4, Vector4 and Quaternion, lets kernels use aligned loads
+// at the cost of padding in containers of these types.
+#ifdef BELLUM_ALIGN_MATH
+#define BELLUM_MATH_ALIGN alignas(16)
+#else
+#define BELLUM_MATH_ALIGN
+#endif
+
+#ifdef BELLUM_SIMD_SSE
+
+namespace bellum {
+namespace simd {
+
+inline __m128 load(const float* p) {
+#ifdef BELLUM_ALIGN_MATH
+  return _mm_load_ps(p);
+#else
+  return _mm_loadu_ps(p);
+#endif
+}
+
+inline void store(float* p, __m128 v) {
+#ifdef BELLUM_ALIGN_MATH
+  _mm_store_ps(p, v);
+#else
+  _mm_storeu_ps(p, v);
+#endif
+}
+
+template<int X, int Y, int Z, int W>
+inline __m128 swizzle(__m128 v) {
+  return _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(v), _MM_SHUFFLE(W, Z, Y, X)));
+}
+
+template<int X, int Y, int Z, int W>
+inline __m128 shuffle(__m128 a, __m128 b) {
+  return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X));
+}
+
+template<int I>
+inline __m128 splat(__m128 v) {
+  return swizzle<I, I, I, I>(v);
+}
+
+// a.yzx * b.zxy - a.zxy * b.yzx, the w lane ends up 0 if both inputs have w 0
+inline __m128 cross(__m128 a, __m128 b) {
+  __m128 r = _mm_sub_ps(_mm_mul_ps(a, swizzle<1, 2, 0, 3>(b)),
+                        _mm_mul_ps(swizzle<1, 2, 0, 3>(a), b));
+  return swizzle<1, 2, 0, 3>(r);
+}
+
+// c0 * v.x + c1 * v.y + c2 * v.z + c3 * v.w, summed in that order
+inline __m128 combine(__m128 c0, __m128 c1, __m128 c2, __m128 c3, __m128 v) {
+  __m128 r = _mm_mul_ps(c0, splat<0>(v));
+  r = _mm_add_ps(r, _mm_mul_ps(c1, splat<1>(v)));
+  r = _mm_add_ps(r, _mm_mul_ps(c2, splat<2>(v)));
+  return _mm_add_ps(r, _mm_mul_ps(c3, splat<3>(v)));
+}
+
+}
+}
+
+#endif
+
+#endif
@@ -13,21 +13,21 @@ struct Vector2 {
   inline void setSquaredMagnitude(float sqrMagnitude);
 
   inline float magnitude() const;
-  inline float squaredMagnitude() const;
+  inline constexpr float squaredMagnitude() const;
   inline Vector2& normalize();
   inline Vector2 normalized() const;
 
-  inline Vector2 operator+(const Vector2& v) const;
-  inline Vector2& operator+=(const Vector2& v);
-  inline Vector2 operator-(const Vector2& v) const;
-  inline Vector2& operator-=(const Vector2& v);
-  inline Vector2 operator-() const;
-  inline Vector2 operator*(float a) const;
-  inline Vector2& operator*=(float a);
-  inline Vector2 operator/(float a) const;
-  inline Vector2& operator/=(float x);
-  inline bool operator==(const Vector2& v) const;
-  inline bool operator!=(const Vector2& v) const;
+  inline constexpr Vector2 operator+(const Vector2& v) const;
+  inline constexpr Vector2& operator+=(const Vector2& v);
+  inline constexpr Vector2 operator-(const Vector2& v) const;
+  inline constexpr Vector2& operator-=(const Vector2& v);
+  inline constexpr Vector2 operator-() const;
+  inline constexpr Vector2 operator*(float a) const;
+  inline constexpr Vector2& operator*=(float a);
+  inline constexpr Vector2 operator/(float a) const;
+  inline constexpr Vector2& operator/=(float x);
+  inline constexpr bool operator==(const Vector2& v) const;
+  inline constexpr bool operator!=(const Vector2& v) const;
 
   inline friend std::ostream& operator<<(std::ostream& os, const Vector2& v);
 };
@@ -51,7 +51,7 @@ inline float Vector2::magnitude() const {
   return Math::sqrt(x * x + y * y);
 }
 
-inline float Vector2::squaredMagnitude() const {
+inline constexpr float Vector2::squaredMagnitude() const {
   return x * x + y * y ;
 }
 
@@ -77,70 +77,74 @@ inline Vector2 Vector2::normalized() const {
 }
 
 // Operators
-inline Vector2 Vector2::operator+(const Vector2& v) const {
+inline constexpr Vector2 Vector2::operator+(const Vector2& v) const {
   return {x + v.x, y + v.y};
 }
 
-inline Vector2& Vector2::operator+=(const Vector2& v) {
+inline constexpr Vector2& Vector2::operator+=(const Vector2& v) {
   x += v.x;
   y += v.y;
   return *this;
 }
 
-inline Vector2 Vector2::operator-(const Vector2& v) const {
+inline constexpr Vector2 Vector2::operator-(const Vector2& v) const {
   return {x - v.x, y - v.y};
 }
 
-inline Vector2& Vector2::operator-=(const Vector2& v) {
+inline constexpr Vector2& Vector2::operator-=(const Vector2& v) {
   x -= v.x;
   y -= v.y;
   return *this;
 }
 
-inline Vector2 Vector2::operator-() const {
+inline constexpr Vector2 Vector2::operator-() const {
   return {-x, -y};
 }
 
-inline Vector2 Vector2::operator*(float a) const {
+inline constexpr Vector2 Vector2::operator*(float a) const {
   return {x * a, y * a};
 }
 
-inline Vector2& Vector2::operator*=(float a) {
+inline constexpr Vector2& Vector2::operator*=(float a) {
   x *= a;
   y *= a;
   return *this;
 }
 
-inline Vector2 Vector2::operator/(const float a) const {
+inline constexpr Vector2 Vector2::operator/(const float a) const {
   return {x / a, y / a};
 }
 
-inline Vector2& Vector2::operator/=(const float a) {
+inline constexpr Vector2& Vector2::operator/=(const float a) {
   x /= a;
   y /= a;
   return *this;
 }
 
-inline bool Vector2::operator==(const Vector2& v) const {
+inline constexpr bool Vector2::operator==(const Vector2& v) const {
   return x == v.x && y == v.y;
 }
 
-inline bool Vector2::operator!=(const Vector2& v) const {
+inline constexpr bool Vector2::operator!=(const Vector2& v) const {
   return x != v.x || y != v.y;
 }
 
-inline Vector2 operator*(float a, const Vector2& v) {
+inline constexpr Vector2 operator*(float a, const Vector2& v) {
   return {
     v.x * a,
-    v.x * a,
+    v.y * a
   };
 }
 
 inline std::ostream& operator<<(std::ostream& os, const Vector2& v) {
-  os << "Vector3(x: " << v.x << ", y: " << v.y << ")";
+  os << "Vector2(x: " << v.x << ", y: " << v.y << ")";
   return os;
 }
 
+inline void formatValue(FormatBuffer& out, const Vector2& v) {
+  out << "Vector2(x: " << v.x << ", y: " << v.y << ')';
+}
+
 }
 
 #endif
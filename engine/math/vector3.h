@@ -13,51 +13,55 @@ struct Vector3 {
   inline void setSquaredMagnitude(float sqrMagnitude);
 
   inline float magnitude() const;
-  inline float squaredMagnitude() const;
+  inline constexpr float squaredMagnitude() const;
+  template<Precision P = Precision::PRECISE>
   inline Vector3& normalize();
+  template<Precision P = Precision::PRECISE>
   inline Vector3 normalized() const;
 
-  inline Vector3 operator+(const Vector3& v) const;
-  inline Vector3& operator+=(const Vector3& v);
-  inline Vector3 operator-(const Vector3& v) const;
-  inline Vector3& operator-=(const Vector3& v);
-  inline Vector3 operator-() const;
-  inline Vector3 operator*(float a) const;
-  inline Vector3& operator*=(float a);
-  inline Vector3 operator/(float a) const;
-  inline Vector3& operator/=(float x);
-  inline bool operator==(const Vector3& v) const;
-  inline bool operator!=(const Vector3& v) const;
+  inline constexpr Vector3 operator+(const Vector3& v) const;
+  inline constexpr Vector3& operator+=(const Vector3& v);
+  inline constexpr Vector3 operator-(const Vector3& v) const;
+  inline constexpr Vector3& operator-=(const Vector3& v);
+  inline constexpr Vector3 operator-() const;
+  inline constexpr Vector3 operator*(float a) const;
+  inline constexpr Vector3& operator*=(float a);
+  inline constexpr Vector3 operator/(float a) const;
+  inline constexpr Vector3& operator/=(float x);
+  inline constexpr bool operator==(const Vector3& v) const;
+  inline constexpr bool operator!=(const Vector3& v) const;
 
   inline static float angle(const Vector3& from, const Vector3& to);
   inline static Vector3 clampMagnitude(const Vector3& v, float max);
-  inline static Vector3 cross(const Vector3& a, const Vector3& b);
+  inline static constexpr Vector3 cross(const Vector3& a, const Vector3& b);
   inline static float distance(const Vector3& a, const Vector3& b);
-  inline static float squaredDistance(const Vector3& a, const Vector3& b);
-  inline static float dot(const Vector3& a);
-  inline static float dot(const Vector3& a, const Vector3& b);
-  inline static Vector3 lerp(const Vector3& a, const Vector3& b, float t);
-  inline static Vector3 lerpUnclamped(const Vector3& a, const Vector3& b, float t);
-  inline static Vector3 max(const Vector3& a, const Vector3& b);
-  inline static Vector3 min(const Vector3& a, const Vector3& b);
+  inline static constexpr float squaredDistance(const Vector3& a, const Vector3& b);
+  inline static constexpr float dot(const Vector3& a);
+  inline static constexpr float dot(const Vector3& a, const Vector3& b);
+  inline static constexpr Vector3 lerp(const Vector3& a, const Vector3& b, float t);
+  inline static constexpr Vector3 lerpUnclamped(const Vector3& a, const Vector3& b, float t);
+  inline static constexpr Vector3 max(const Vector3& a, const Vector3& b);
+  inline static constexpr Vector3 min(const Vector3& a, const Vector3& b);
   inline static Vector3 moveTowards(const Vector3& current, const Vector3& target, float delta);
-  inline static Vector3 project(const Vector3& v, const Vector3& on);
+  inline static constexpr Vector3 project(const Vector3& v, const Vector3& on);
   inline static Vector3 projectOnPlane(const Vector3& v, const Vector3& planeNormal);
-  inline static Vector3 reflect(const Vector3& in, const Vector3& normal);
+  inline static constexpr Vector3 reflect(const Vector3& in, const Vector3& normal);
   inline static Vector3 rotate(const Vector3& v, const Vector3& axis, float angle);
+  template<Precision P = Precision::PRECISE>
   inline static Vector3 slerp(const Vector3& a, const Vector3& b, float t);
+  template<Precision P = Precision::PRECISE>
   inline static Vector3 slerpUnclamped(const Vector3& a, const Vector3& b, float t);
-  inline static Vector3 clamp(const Vector3& v, const Vector3& min, const Vector3& max);
-  inline static Vector3 scale(const Vector3& a, const Vector3& b);
-
-  inline static const Vector3& back();
-  inline static const Vector3& down();
-  inline static const Vector3& forward();
-  inline static const Vector3& left();
-  inline static const Vector3& right();
-  inline static const Vector3& up();
-  inline static const Vector3& zero();
-  inline static const Vector3& one();
+  inline static constexpr Vector3 clamp(const Vector3& v, const Vector3& min, const Vector3& max);
+  inline static constexpr Vector3 scale(const Vector3& a, const Vector3& b);
+
+  inline static constexpr Vector3 back();
+  inline static constexpr Vector3 down();
+  inline static constexpr Vector3 forward();
+  inline static constexpr Vector3 left();
+  inline static constexpr Vector3 right();
+  inline static constexpr Vector3 up();
+  inline static constexpr Vector3 zero();
+  inline static constexpr Vector3 one();
 
   inline friend std::ostream& operator<<(std::ostream& os, const Vector3& v);
 };
@@ -82,11 +86,20 @@ inline float Vector3::magnitude() const {
   return Math::sqrt(x * x + y * y + z * z);
 }
 
-inline float Vector3::squaredMagnitude() const {
+inline constexpr float Vector3::squaredMagnitude() const {
   return x * x + y * y + z * z;
 }
 
+template<Precision P>
 inline Vector3& Vector3::normalize() {
+  if (P == Precision::FAST) {
+    float sm = squaredMagnitude();
+    if (sm != 0.0f) {
+      *this *= FastMath::rsqrt(sm);
+    }
+    return *this;
+  }
+
   float m = magnitude();
 
   if (m != 0.0f) {
@@ -98,7 +111,13 @@ inline Vector3& Vector3::normalize() {
   return *this;
 }
 
+template<Precision P>
 inline Vector3 Vector3::normalized() const {
+  if (P == Precision::FAST) {
+    Vector3 result = *this;
+    return result.normalize<P>();
+  }
+
   float m = magnitude();
 
   if (m != 0.0f) {
@@ -109,67 +128,67 @@ inline Vector3 Vector3::normalized() const {
 }
 
 // Operators
-inline Vector3 Vector3::operator+(const Vector3& v) const {
+inline constexpr Vector3 Vector3::operator+(const Vector3& v) const {
   return {x + v.x, y + v.y, z + v.z};
 }
 
-inline Vector3& Vector3::operator+=(const Vector3& v) {
+inline constexpr Vector3& Vector3::operator+=(const Vector3& v) {
   x += v.x;
   y += v.y;
   z += v.z;
   return *this;
 }
 
-inline Vector3 Vector3::operator-(const Vector3& v) const {
+inline constexpr Vector3 Vector3::operator-(const Vector3& v) const {
   return {x - v.x, y - v.y, z - v.z};
 }
 
-inline Vector3& Vector3::operator-=(const Vector3& v) {
+inline constexpr Vector3& Vector3::operator-=(const Vector3& v) {
   x -= v.x;
   y -= v.y;
   z -= v.z;
   return *this;
 }
 
-inline Vector3 Vector3::operator-() const {
+inline constexpr Vector3 Vector3::operator-() const {
   return {-x, -y, -z};
 }
 
-inline Vector3 Vector3::operator*(float a) const {
+inline constexpr Vector3 Vector3::operator*(float a) const {
   return {x * a, y * a, z * a};
 }
 
-inline Vector3& Vector3::operator*=(float a) {
+inline constexpr Vector3& Vector3::operator*=(float a) {
   x *= a;
   y *= a;
   z *= a;
   return *this;
 }
 
-inline Vector3 Vector3::operator/(const float a) const {
+inline constexpr Vector3 Vector3::operator/(const float a) const {
   return {x / a, y / a, z / a};
 }
 
-inline Vector3& Vector3::operator/=(const float a) {
+inline constexpr Vector3& Vector3::operator/=(const float a) {
   x /= a;
   y /= a;
   z /= a;
   return *this;
 }
 
-inline bool Vector3::operator==(const Vector3& v) const {
+inline constexpr bool Vector3::operator==(const Vector3& v) const {
   return x == v.x && y == v.y && z == v.z;
 }
 
-inline bool Vector3::operator!=(const Vector3& v) const {
+inline constexpr bool Vector3::operator!=(const Vector3& v) const {
   return x != v.x || y != v.y || z != v.z;
 }
 
-inline Vector3 operator*(float a, const Vector3& v) {
+inline constexpr Vector3 operator*(float a, const Vector3& v) {
   return {
     v.x * a,
-    v.x * a,
-    v.z * a,
+    v.y * a,
+    v.z * a
   };
 }
 
@@ -197,7 +216,7 @@ inline Vector3 Vector3::clampMagnitude(const Vector3& v, float max) {
   return result;
 }
 
-inline Vector3 Vector3::cross(const Vector3& a, const Vector3& b) {
+inline constexpr Vector3 Vector3::cross(const Vector3& a, const Vector3& b) {
   return {
     a.y * b.z - b.y * a.z,
     a.z * b.x - b.z * a.x,
@@ -212,26 +231,26 @@ inline float Vector3::distance(const Vector3& a, const Vector3& b) {
   return Math::sqrt(dx * dx + dy * dy + dz * dz);
 }
 
-inline float Vector3::squaredDistance(const Vector3& a, const Vector3& b) {
+inline constexpr float Vector3::squaredDistance(const Vector3& a, const Vector3& b) {
   float dx = b.x - a.x;
   float dy = b.y - a.y;
   float dz = b.z - a.z;
   return dx * dx + dy * dy + dz * dz;
 }
 
-inline float Vector3::dot(const Vector3& a) {
+inline constexpr float Vector3::dot(const Vector3& a) {
   return a.x * a.x + a.y * a.y + a.z * a.z;
 }
 
-inline float Vector3::dot(const Vector3& a, const Vector3& b) {
+inline constexpr float Vector3::dot(const Vector3& a, const Vector3& b) {
   return a.x * b.x + a.y * b.y + a.z * b.z;
 }
 
-inline Vector3 Vector3::lerp(const Vector3& a, const Vector3& b, float t) {
+inline constexpr Vector3 Vector3::lerp(const Vector3& a, const Vector3& b, float t) {
   return lerpUnclamped(a, b, Math::clamp(t, 0.0f, 1.0f));
 }
 
-inline Vector3 Vector3::lerpUnclamped(const Vector3& a, const Vector3& b, float t) {
+inline constexpr Vector3 Vector3::lerpUnclamped(const Vector3& a, const Vector3& b, float t) {
   return {
     a.x + (b.x - a.x) * t,
     a.y + (b.y - a.y) * t,
@@ -239,7 +258,7 @@ inline Vector3 Vector3::lerpUnclamped(const Vector3& a, const Vector3& b, float
   };
 }
 
-inline Vector3 Vector3::max(const Vector3& a, const Vector3& b) {
+inline constexpr Vector3 Vector3::max(const Vector3& a, const Vector3& b) {
   return {
     Math::max(a.x, b.x),
     Math::max(a.y, b.y),
@@ -247,7 +266,7 @@ inline Vector3 Vector3::max(const Vector3& a, const Vector3& b) {
   };
 }
 
-inline Vector3 Vector3::min(const Vector3& a, const Vector3& b) {
+inline constexpr Vector3 Vector3::min(const Vector3& a, const Vector3& b) {
   return {
     Math::min(a.x, b.x),
     Math::min(a.y, b.y),
@@ -260,7 +279,7 @@ Vector3 Vector3::moveTowards(const Vector3& current, const Vector3& target, floa
   return current + d * delta;
 }
 
-inline Vector3 Vector3::project(const Vector3& v, const Vector3& on) {
+inline constexpr Vector3 Vector3::project(const Vector3& v, const Vector3& on) {
   return on * (dot(on, v) / on.squaredMagnitude());
 }
 
@@ -268,7 +287,7 @@ Vector3 Vector3::projectOnPlane(const Vector3& v, const Vector3& planeNormal) {
   return v - project(v, planeNormal);
 }
 
-inline Vector3 Vector3::reflect(const Vector3& in, const Vector3& normal) {
+inline constexpr Vector3 Vector3::reflect(const Vector3& in, const Vector3& normal) {
   return in - 2.0f * dot(in, normal) * normal;
 }
 
@@ -279,10 +298,12 @@ inline Vector3 Vector3::rotate(const Vector3& v, const Vector3& axis, float angl
   return cross(v, axis * sin) + v * cos + axis * dot(axis * (1.0f - cos));
 }
 
+template<Precision P>
 inline Vector3 Vector3::slerp(const Vector3& a, const Vector3& b, float t) {
-  return slerpUnclamped(a, b, Math::clamp(t, 0.0f, 1.0f));
+  return slerpUnclamped<P>(a, b, Math::clamp(t, 0.0f, 1.0f));
 }
 
+template<Precision P>
 inline Vector3 Vector3::slerpUnclamped(const Vector3& a, const Vector3& b, float t) {
   float d = dot(a, b);
 
@@ -290,25 +311,24 @@ inline Vector3 Vector3::slerpUnclamped(const Vector3& a, const Vector3& b, float
     return lerp(a, b, t);
   }
 
-  float theta0 = Math::acos(d);
+  float theta0 = Math::acos<P>(d);
   float theta = theta0 * t;
 
-  float st = Math::sin(theta);
+  float st, cost;
+  Math::sincos<P>(theta, st, cost);
   float tx = b.x - a.x * d;
   float ty = b.y - a.y * d;
   float tz = b.z - a.z * d;
   float l2 = tx * tx + ty * ty + tz * tz;
-  float dl = st * ((l2 < 0.0001f) ? 1.0f : 1.0f / Math::sqrt(l2));
-
-  float cost = Math::cos(theta);
+  float dl = st * ((l2 < 0.0001f) ? 1.0f : Math::rsqrt<P>(l2));
 
   return Vector3{a.x * cost + (tx * dl),
                  a.y * cost + (ty * dl),
                  a.z * cost + (tz * dl)}
-    .normalized();
+    .normalized<P>();
 }
 
-inline Vector3 Vector3::clamp(const Vector3& v, const Vector3& min, const Vector3& max) {
+inline constexpr Vector3 Vector3::clamp(const Vector3& v, const Vector3& min, const Vector3& max) {
   return {
     Math::clamp(v.x, min.x, max.x),
     Math::clamp(v.y, min.y, max.y),
@@ -316,7 +336,7 @@ inline Vector3 Vector3::clamp(const Vector3& v, const Vector3& min, const Vector
   };
 }
 
-inline Vector3 Vector3::scale(const Vector3& a, const Vector3& b) {
+inline constexpr Vector3 Vector3::scale(const Vector3& a, const Vector3& b) {
   return {
     a.x * b.x,
     a.y * b.y,
@@ -324,45 +344,37 @@ inline Vector3 Vector3::scale(const Vector3& a, const Vector3& b) {
   };
 }
 
-// Singletons
-const Vector3& Vector3::back() {
-  static Vector3 v{0.0f, 0.0f, -1.0f};
-  return v;
+// Constants
+inline constexpr Vector3 Vector3::back() {
+  return {0.0f, 0.0f, -1.0f};
 }
 
-const Vector3& Vector3::down() {
-  static Vector3 v{0.0f, -1.0f, 0.0f};
-  return v;
+inline constexpr Vector3 Vector3::down() {
+  return {0.0f, -1.0f, 0.0f};
 }
 
-const Vector3& Vector3::forward() {
-  static Vector3 v{0.0f, 0.0f, 1.0f};
-  return v;
+inline constexpr Vector3 Vector3::forward() {
+  return {0.0f, 0.0f, 1.0f};
 }
 
-const Vector3& Vector3::left() {
-  static Vector3 v{-1.0f, 0.0f, 0.0f};
-  return v;
+inline constexpr Vector3 Vector3::left() {
+  return {-1.0f, 0.0f, 0.0f};
 }
 
-const Vector3& Vector3::right() {
-  static Vector3 v{1.0f, 0.0f, 0.0f};
-  return v;
+inline constexpr Vector3 Vector3::right() {
+  return {1.0f, 0.0f, 0.0f};
 }
 
-const Vector3& Vector3::up() {
-  static Vector3 v{0.0f, 1.0f, 0.0f};
-  return v;
+inline constexpr Vector3 Vector3::up() {
+  return {0.0f, 1.0f, 0.0f};
 }
 
-const Vector3& Vector3::zero() {
-  static Vector3 v{0.0f, 0.0f, 0.0f};
-  return v;
+inline constexpr Vector3 Vector3::zero() {
+  return {0.0f, 0.0f, 0.0f};
 }
 
-const Vector3& Vector3::one() {
-  static Vector3 v{1.0f, 1.0f, 1.0f};
-  return v;
+inline constexpr Vector3 Vector3::one() {
+  return {1.0f, 1.0f, 1.0f};
 }
 
 inline std::ostream& operator<<(std::ostream& os, const Vector3& v) {
@@ -370,6 +382,10 @@ inline std::ostream& operator<<(std::ostream& os, const Vector3& v) {
   return os;
 }
 
+inline void formatValue(FormatBuffer& out, const Vector3& v) {
+  out << "Vector3(x: " << v.x << ", y: " << v.y << ", z: " << v.z << ')';
+}
+
 }
 
 #endif
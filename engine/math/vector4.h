@@ -2,46 +2,47 @@
 #define BELLUM_VECTOR4_H
 
 #include "vector3.h"
+#include "simd.h"
 
 namespace bellum {
 
-struct Vector4 {
+struct BELLUM_MATH_ALIGN Vector4 {
   float x, y, z, w;
 
   inline void setMagnitude(float magnitude);
   inline void setSquaredMagnitude(float sqrMagnitude);
 
   inline float magnitude() const;
-  inline float squaredMagnitude() const;
+  inline constexpr float squaredMagnitude() const;
   inline Vector4& normalize();
   inline Vector4 normalized() const;
 
-  inline Vector4 operator+(const Vector4& v) const;
-  inline Vector4& operator+=(const Vector4& v);
-  inline Vector4 operator-(const Vector4& v) const;
-  inline Vector4& operator-=(const Vector4& v);
-  inline Vector4 operator-() const;
-  inline Vector4 operator*(float a) const;
-  inline Vector4& operator*=(float a);
-  inline Vector4 operator/(float a) const;
-  inline Vector4& operator/=(float x);
-  inline bool operator==(const Vector4& v) const;
-  inline bool operator!=(const Vector4& v) const;
+  inline constexpr Vector4 operator+(const Vector4& v) const;
+  inline constexpr Vector4& operator+=(const Vector4& v);
+  inline constexpr Vector4 operator-(const Vector4& v) const;
+  inline constexpr Vector4& operator-=(const Vector4& v);
+  inline constexpr Vector4 operator-() const;
+  inline constexpr Vector4 operator*(float a) const;
+  inline constexpr Vector4& operator*=(float a);
+  inline constexpr Vector4 operator/(float a) const;
+  inline constexpr Vector4& operator/=(float x);
+  inline constexpr bool operator==(const Vector4& v) const;
+  inline constexpr bool operator!=(const Vector4& v) const;
 
   inline static float distance(const Vector4& a, const Vector4& b);
-  inline static float squaredDistance(const Vector4& a, const Vector4& b);
-  inline static float dot(const Vector4& a);
-  inline static float dot(const Vector4& a, const Vector4& b);
-  inline static Vector4 lerp(const Vector4& a, const Vector4& b, float t);
-  inline static Vector4 lerpUnclamped(const Vector4& a, const Vector4& b, float t);
-  inline static Vector4 max(const Vector4& a, const Vector4& b);
-  inline static Vector4 min(const Vector4& a, const Vector4& b);
+  inline static constexpr float squaredDistance(const Vector4& a, const Vector4& b);
+  inline static constexpr float dot(const Vector4& a);
+  inline static constexpr float dot(const Vector4& a, const Vector4& b);
+  inline static constexpr Vector4 lerp(const Vector4& a, const Vector4& b, float t);
+  inline static constexpr Vector4 lerpUnclamped(const Vector4& a, const Vector4& b, float t);
+  inline static constexpr Vector4 max(const Vector4& a, const Vector4& b);
+  inline static constexpr Vector4 min(const Vector4& a, const Vector4& b);
   inline static Vector4 moveTowards(const Vector4& current, const Vector4& target, float delta);
-  inline static Vector4 project(const Vector4& v, const Vector4& on);
-  inline static Vector4 scale(const Vector4& a, const Vector4& b);
+  inline static constexpr Vector4 project(const Vector4& v, const Vector4& on);
+  inline static constexpr Vector4 scale(const Vector4& a, const Vector4& b);
 
-  inline static const Vector4& zero();
-  inline static const Vector4& one();
+  inline static constexpr Vector4 zero();
+  inline static constexpr Vector4 one();
 
   inline friend std::ostream& operator<<(std::ostream& os, const Vector4& vector3);
 };
@@ -67,7 +68,7 @@ inline float Vector4::magnitude() const {
   return Math::sqrt(x * x + y * y + z * z + w * w);
 }
 
-inline float Vector4::squaredMagnitude() const {
+inline constexpr float Vector4::squaredMagnitude() const {
   return x * x + y * y + z * z + w * w;
 }
 
@@ -95,11 +96,11 @@ inline Vector4 Vector4::normalized() const {
 }
 
 // Operators
-inline Vector4 Vector4::operator+(const Vector4& v) const {
+inline constexpr Vector4 Vector4::operator+(const Vector4& v) const {
   return {x + v.x, y + v.y, z + v.z, w + v.w};
 }
 
-inline Vector4& Vector4::operator+=(const Vector4& v) {
+inline constexpr Vector4& Vector4::operator+=(const Vector4& v) {
   x += v.x;
   y += v.y;
   z += v.z;
@@ -107,11 +108,11 @@ inline Vector4& Vector4::operator+=(const Vector4& v) {
   return *this;
 }
 
-inline Vector4 Vector4::operator-(const Vector4& v) const {
+inline constexpr Vector4 Vector4::operator-(const Vector4& v) const {
   return {x - v.x, y - v.y, z - v.z, w - v.w};
 }
 
-inline Vector4& Vector4::operator-=(const Vector4& v) {
+inline constexpr Vector4& Vector4::operator-=(const Vector4& v) {
   x -= v.x;
   y -= v.y;
   z -= v.z;
@@ -119,15 +120,15 @@ inline Vector4& Vector4::operator-=(const Vector4& v) {
   return *this;
 }
 
-inline Vector4 Vector4::operator-() const {
+inline constexpr Vector4 Vector4::operator-() const {
   return {-x, -y, -z, -w};
 }
 
-inline Vector4 Vector4::operator*(float a) const {
+inline constexpr Vector4 Vector4::operator*(float a) const {
   return {x * a, y * a, z * a, w * a};
 }
 
-inline Vector4& Vector4::operator*=(float a) {
+inline constexpr Vector4& Vector4::operator*=(float a) {
   x *= a;
   y *= a;
   z *= a;
@@ -135,11 +136,11 @@ inline Vector4& Vector4::operator*=(float a) {
   return *this;
 }
 
-inline Vector4 Vector4::operator/(const float a) const {
+inline constexpr Vector4 Vector4::operator/(const float a) const {
   return {x / a, y / a, z / a, w / a};
 }
 
-inline Vector4& Vector4::operator/=(const float a) {
+inline constexpr Vector4& Vector4::operator/=(const float a) {
   x /= a;
   y /= a;
   z /= a;
@@ -147,18 +148,18 @@ inline Vector4& Vector4::operator/=(const float a) {
   return *this;
 }
 
-inline bool Vector4::operator==(const Vector4& v) const {
+inline constexpr bool Vector4::operator==(const Vector4& v) const {
   return x == v.x && y == v.y && z == v.z && w == v.w;
 }
 
-inline bool Vector4::operator!=(const Vector4& v) const {
+inline constexpr bool Vector4::operator!=(const Vector4& v) const {
   return x != v.x || y != v.y || z != v.z || w != v.w;
 }
 
-inline Vector4 operator*(float a, const Vector4& v) {
+inline constexpr Vector4 operator*(float a, const Vector4& v) {
   return {
     v.x * a,
-    v.x * a,
+    v.y * a,
     v.z * a,
     v.w * a
   };
@@ -173,7 +174,7 @@ inline float Vector4::distance(const Vector4& a, const Vector4& b) {
   return Math::sqrt(dx * dx + dy * dy + dz * dz + dw * dw);
 }
 
-inline float Vector4::squaredDistance(const Vector4& a, const Vector4& b) {
+inline constexpr float Vector4::squaredDistance(const Vector4& a, const Vector4& b) {
   float dx = b.x - a.x;
   float dy = b.y - a.y;
   float dz = b.z - a.z;
@@ -181,19 +182,19 @@ inline float Vector4::squaredDistance(const Vector4& a, const Vector4& b) {
   return dx * dx + dy * dy + dz * dz + dw * dw;
 }
 
-inline float Vector4::dot(const Vector4& a) {
+inline constexpr float Vector4::dot(const Vector4& a) {
   return a.x * a.x + a.y * a.y + a.z * a.z + a.w * a.w;
 }
 
-inline float Vector4::dot(const Vector4& a, const Vector4& b) {
-  return a.x * b.x + a.y * b.y + a.z * b.z + a.w + b.w;
+inline constexpr float Vector4::dot(const Vector4& a, const Vector4& b) {
+  return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
 }
 
-inline Vector4 Vector4::lerp(const Vector4& a, const Vector4& b, float t) {
+inline constexpr Vector4 Vector4::lerp(const Vector4& a, const Vector4& b, float t) {
   return lerpUnclamped(a, b, Math::clamp(t, 0.0f, 1.0f));
 }
 
-inline Vector4 Vector4::lerpUnclamped(const Vector4& a, const Vector4& b, float t) {
+inline constexpr Vector4 Vector4::lerpUnclamped(const Vector4& a, const Vector4& b, float t) {
   return {
     a.x + (b.x - a.x) * t,
     a.y + (b.y - a.y) * t,
@@ -202,7 +203,7 @@ inline Vector4 Vector4::lerpUnclamped(const Vector4& a, const Vector4& b, float
   };
 }
 
-inline Vector4 Vector4::max(const Vector4& a, const Vector4& b) {
+inline constexpr Vector4 Vector4::max(const Vector4& a, const Vector4& b) {
   return {
     Math::max(a.x, b.x),
     Math::max(a.y, b.y),
@@ -211,7 +212,7 @@ inline Vector4 Vector4::max(const Vector4& a, const Vector4& b) {
   };
 }
 
-inline Vector4 Vector4::min(const Vector4& a, const Vector4& b) {
+inline constexpr Vector4 Vector4::min(const Vector4& a, const Vector4& b) {
   return {
     Math::min(a.x, b.x),
     Math::min(a.y, b.y),
@@ -225,23 +226,21 @@ Vector4 Vector4::moveTowards(const Vector4& current, const Vector4& target, floa
   return current + d * delta;
 }
 
-inline Vector4 Vector4::project(const Vector4& v, const Vector4& on) {
+inline constexpr Vector4 Vector4::project(const Vector4& v, const Vector4& on) {
   return on * (dot(on, v) / on.squaredMagnitude());
 }
 
-inline Vector4 Vector4::scale(const Vector4& a, const Vector4& b) {
+inline constexpr Vector4 Vector4::scale(const Vector4& a, const Vector4& b) {
   return {a.x * b.x, a.y * b.y, a.z * b.z, a.w * b.w};
 }
 
-// Singletons
-const Vector4& Vector4::zero() {
-  static Vector4 v{0.0f, 0.0f, 0.0f, 0.0f};
-  return v;
+// Constants
+inline constexpr Vector4 Vector4::zero() {
+  return {0.0f, 0.0f, 0.0f, 0.0f};
 }
 
-const Vector4& Vector4::one() {
-  static Vector4 v{1.0f, 1.0f, 1.0f, 1.0f};
-  return v;
+inline constexpr Vector4 Vector4::one() {
+  return {1.0f, 1.0f, 1.0f, 1.0f};
 }
 
 inline std::ostream& operator<<(std::ostream& os, const Vector4& v) {
@@ -249,6 +248,10 @@ inline std::ostream& operator<<(std::ostream& os, const Vector4& v) {
   return os;
 }
 
+inline void formatValue(FormatBuffer& out, const Vector4& v) {
+  out << "Vector4(x: " << v.x << ", y: " << v.y << ", z: " << v.z << ", w: " << v.w << ')';
+}
+
 }
 
 #endif
@@ -12,6 +12,7 @@ public:
   Module() {}
 
   virtual void onStart(Scene* scene) = 0;
+  virtual void onExit() {};
   virtual void update() {};
   virtual void render() {};
 
@@ -12,6 +12,8 @@ class Node {
   friend class SceneManager;
 
 public:
+  BELLUM_TRACK_MEMORY(SCENE)
+
   Node(int32 id)
     : id_(id), active_(true) {}
 
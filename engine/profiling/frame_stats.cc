@@ -0,0 +1,203 @@
+#include "frame_stats.h"
+#include <algorithm>
+#include <fstream>
+
+namespace bellum {
+
+std::array<FrameStats::Sample, FrameStats::kCapacity> FrameStats::samples_;
+std::atomic<uint64> FrameStats::head_{0};
+
+namespace {
+
+std::vector<float> metricValues(const std::vector<FrameStats::Sample>& samples,
+                                FrameStats::Metric metric) {
+  std::vector<float> values;
+  values.reserve(samples.size());
+  for (const auto& sample : samples) {
+    values.push_back(sample[metric]);
+  }
+  return values;
+}
+
+// Nearest-rank percentile, partially reorders values
+float percentile(std::vector<float>& values, float p) {
+  size_t rank = static_cast<size_t>(p * (values.size() - 1) + 0.5f);
+  std::nth_element(values.begin(), values.begin() + rank, values.end());
+  return values[rank];
+}
+
+}
+
+void FrameStats::record(const Sample& sample) {
+  uint64 head = head_.load(std::memory_order_relaxed);
+  samples_[head & (kCapacity - 1)] = sample;
+  head_.store(head + 1, std::memory_order_release);
+}
+
+std::vector<FrameStats::Sample> FrameStats::samples(uint32 window) {
+  uint64 head = head_.load(std::memory_order_acquire);
+  uint64 count = std::min<uint64>({window, head, kCapacity});
+
+  std::vector<Sample> result;
+  result.reserve(count);
+  for (uint64 i = head - count; i < head; i++) {
+    result.push_back(samples_[i & (kCapacity - 1)]);
+  }
+
+  // drop the oldest entries if the writer lapped them while copying
+  uint64 current = head_.load(std::memory_order_acquire);
+  uint64 firstValid = current + 1 > kCapacity ? current + 1 - kCapacity : 0;
+  uint64 first = head - count;
+  if (first < firstValid) {
+    uint64 overwritten = std::min<uint64>(firstValid - first, result.size());
+    result.erase(result.begin(), result.begin() + overwritten);
+  }
+
+  return result;
+}
+
+uint64 FrameStats::frameCount() {
+  return head_.load(std::memory_order_acquire);
+}
+
+FrameStats::Summary FrameStats::summary(Metric metric, uint32 window) {
+  std::vector<float> values = metricValues(samples(window), metric);
+  if (values.empty()) {
+    return {0, 0.0f, 0.0f, 0.0f, 0.0f};
+  }
+
+  Summary result;
+  result.count = static_cast<uint32>(values.size());
+  result.max = *std::max_element(values.begin(), values.end());
+  result.p50 = percentile(values, 0.50f);
+  result.p95 = percentile(values, 0.95f);
+  result.p99 = percentile(values, 0.99f);
+  return result;
+}
+
+std::vector<uint32> FrameStats::histogram(Metric metric,
+                                          float bucketMs,
+                                          uint32 bucketCount,
+                                          uint32 window) {
+  std::vector<uint32> buckets(bucketCount, 0);
+  if (bucketCount == 0 || bucketMs <= 0.0f) {
+    return buckets;
+  }
+
+  // the last bucket collects everything above the range
+  for (const auto& sample : samples(window)) {
+    uint32 i = static_cast<uint32>(std::max(sample[metric], 0.0f) / bucketMs);
+    buckets[std::min(i, bucketCount - 1)]++;
+  }
+
+  return buckets;
+}
+
+bool FrameStats::dump(const std::string& path) {
+  std::ofstream out{path};
+  if (!out.is_open()) {
+    return false;
+  }
+
+  std::vector<Sample> all = samples();
+  bool json = path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0;
+
+  if (json) {
+    dumpJson(out, all);
+  } else {
+    dumpCsv(out, all);
+  }
+
+  return out.good();
+}
+
+void FrameStats::dumpCsv(std::ostream& out, const std::vector<Sample>& samples) {
+  uint64 frame = frameCount() - samples.size();
+
+  out << "frame";
+  for (uint32 m = 0; m < static_cast<uint32>(Metric::COUNT); m++) {
+    out << ',' << metricName(static_cast<Metric>(m)) << "_ms";
+  }
+  for (uint32 c = 0; c < static_cast<uint32>(RenderStats::Counter::COUNT); c++) {
+    out << ',' << RenderStats::counterName(static_cast<RenderStats::Counter>(c));
+  }
+  out << '\n';
+
+  for (const auto& sample : samples) {
+    out << frame++;
+    for (float value : sample.values) {
+      out << ',' << value;
+    }
+    for (uint64 value : sample.render.values) {
+      out << ',' << value;
+    }
+    out << '\n';
+  }
+}
+
+void FrameStats::dumpJson(std::ostream& out, const std::vector<Sample>& samples) {
+  static constexpr float kBucketMs = 1.0f;
+  static constexpr uint32 kBucketCount = 100;
+
+  out << "{\n  \"frames\": " << samples.size() << ",\n  \"metrics\": {";
+
+  for (uint32 m = 0; m < static_cast<uint32>(Metric::COUNT); m++) {
+    Metric metric = static_cast<Metric>(m);
+    Summary s = summary(metric, static_cast<uint32>(samples.size()));
+
+    out << (m == 0 ? "\n" : ",\n");
+    out << "    \"" << metricName(metric) << "\": {"
+        << "\"p50\": " << s.p50 << ", "
+        << "\"p95\": " << s.p95 << ", "
+        << "\"p99\": " << s.p99 << ", "
+        << "\"max\": " << s.max << ", "
+        << "\"histogram\": {\"bucket_ms\": " << kBucketMs << ", \"counts\": [";
+
+    std::vector<uint32> buckets = histogram(metric, kBucketMs, kBucketCount,
+                                            static_cast<uint32>(samples.size()));
+    for (uint32 i = 0; i < buckets.size(); i++) {
+      out << (i == 0 ? "" : ", ") << buckets[i];
+    }
+    out << "]}}";
+  }
+
+  out << "\n  },\n  \"render\": {";
+
+  for (uint32 c = 0; c < static_cast<uint32>(RenderStats::Counter::COUNT); c++) {
+    uint64 total = 0;
+    uint64 max = 0;
+    for (const auto& sample : samples) {
+      total += sample.render.values[c];
+      max = std::max(max, sample.render.values[c]);
+    }
+
+    out << (c == 0 ? "\n" : ",\n");
+    out << "    \"" << RenderStats::counterName(static_cast<RenderStats::Counter>(c)) << "\": {"
+        << "\"mean\": " << (samples.empty() ? 0.0 : static_cast<double>(total) / samples.size())
+        << ", \"max\": " << max << "}";
+  }
+
+  out << "\n  }\n}\n";
+}
+
+const char* FrameStats::metricName(Metric metric) {
+  switch (metric) {
+    case Metric::UPDATE:
+      return "update";
+    case Metric::RENDER:
+      return "render";
+    case Metric::SWAP:
+      return "swap";
+    case Metric::FRAME:
+      return "frame";
+    case Metric::GPU:
+      return "gpu";
+    case Metric::INPUT:
+      return "input";
+    case Metric::COUNT:
+      break;
+  }
+  return "unknown";
+}
+
+}
@@ -0,0 +1,79 @@
+#ifndef BELLUM_FRAME_STATS_H
+#define BELLUM_FRAME_STATS_H
+
+#include <array>
+#include <atomic>
+#include "../common.h"
+#include "../render/render_stats.h"
+
+namespace bellum {
+
+class FrameStats {
+public:
+  enum class Metric : uint8 {
+    UPDATE,
+    RENDER,
+    SWAP,
+    FRAME,
+    GPU,
+    INPUT,
+    COUNT
+  };
+
+  // Timings of a single frame in milliseconds, indexed by Metric, and its render counters. GPU
+  // time lags a few frames behind and is only measured while profiling. INPUT is the age of the
+  // newest cursor sample the frame shows once its buffer swap returned.
+  struct Sample {
+    std::array<float, static_cast<size_t>(Metric::COUNT)> values;
+    RenderStats::Counters render;
+
+    inline float& operator[](Metric metric) {
+      return values[static_cast<size_t>(metric)];
+    }
+
+    inline float operator[](Metric metric) const {
+      return values[static_cast<size_t>(metric)];
+    }
+  };
+
+  struct Summary {
+    uint32 count;
+    float p50;
+    float p95;
+    float p99;
+    float max;
+  };
+
+  // Must be a power of two
+  static constexpr uint32 kCapacity = 4096;
+
+  // Only called from the main loop thread, readers may run concurrently on any thread.
+  static void record(const Sample& sample);
+
+  // Statistics over the most recent 'window' frames
+  static Summary summary(Metric metric, uint32 window = kCapacity);
+  static std::vector<uint32> histogram(Metric metric,
+                                       float bucketMs,
+                                       uint32 bucketCount,
+                                       uint32 window = kCapacity);
+  static std::vector<Sample> samples(uint32 window = kCapacity);
+  static uint64 frameCount();
+
+  // Writes all buffered samples as CSV, or as JSON with summaries if the path ends with '.json'
+  static bool dump(const std::string& path);
+
+  static const char* metricName(Metric metric);
+
+private:
+  FrameStats() {}
+
+  static void dumpCsv(std::ostream& out, const std::vector<Sample>& samples);
+  static void dumpJson(std::ostream& out, const std::vector<Sample>& samples);
+
+  static std::array<Sample, kCapacity> samples_;
+  static std::atomic<uint64> head_;
+};
+
+}
+
+#endif
@@ -0,0 +1,149 @@
+#include "profiler.h"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+namespace bellum {
+
+std::atomic<bool> Profiler::enabled_{false};
+std::mutex Profiler::tracks_mutex_;
+std::vector<std::unique_ptr<Profiler::Track>> Profiler::tracks_;
+
+namespace {
+
+void writeJsonString(std::ostream& out, const std::string& value) {
+  out << '"';
+  for (char c : value) {
+    if (c == '"' || c == '\\') {
+      out << '\\';
+    }
+    out << c;
+  }
+  out << '"';
+}
+
+}
+
+void Profiler::setEnabled(bool enabled) {
+  enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void Profiler::setThreadName(const std::string& name) {
+  Track* track = threadTrack();
+  std::lock_guard<std::mutex> lock{tracks_mutex_};
+  track->name = name;
+}
+
+int64 Profiler::now() {
+  using namespace std::chrono;
+  return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+Profiler::Track* Profiler::makeTrack(const std::string& name) {
+  // tracks are never freed so events of finished threads can still be exported
+  std::unique_ptr<Track> track = std::make_unique<Track>();
+  track->head = std::make_unique<Chunk>();
+  track->tail = track->head.get();
+
+  std::lock_guard<std::mutex> lock{tracks_mutex_};
+  track->id = static_cast<uint32>(tracks_.size()) + 1;
+  track->name = name.empty() ? "Thread " + std::to_string(track->id) : name;
+  tracks_.push_back(std::move(track));
+  return tracks_.back().get();
+}
+
+void Profiler::record(Track* track, const char* name, int64 begin, int64 end, uint32 depth) {
+  append(track, Event{name, begin, end, depth});
+}
+
+Profiler::Track* Profiler::threadTrack() {
+  static thread_local Track* track = nullptr;
+
+  if (track == nullptr) {
+    track = makeTrack("");
+  }
+
+  return track;
+}
+
+void Profiler::endScope(const char* name, int64 begin, uint32 depth) {
+  int64 end = now();
+  Track* track = threadTrack();
+  track->depth = depth;
+  append(track, Event{name, begin, end, depth});
+}
+
+void Profiler::append(Track* track, const Event& event) {
+  Chunk* chunk = track->tail;
+  uint32 count = chunk->count.load(std::memory_order_relaxed);
+
+  if (count == kChunkSize) {
+    if (track->chunk_count == kMaxChunks) {
+      track->dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    Chunk* next = new Chunk{};
+    chunk->next.store(next, std::memory_order_release);
+    track->tail = next;
+    track->chunk_count++;
+    chunk = next;
+    count = 0;
+  }
+
+  chunk->events[count] = event;
+  chunk->count.store(count + 1, std::memory_order_release);
+}
+
+bool Profiler::exportChromeTrace(const std::string& path) {
+  std::ofstream out{path};
+  if (!out.is_open()) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock{tracks_mutex_};
+  bool first = true;
+
+  out << std::fixed << std::setprecision(3);
+  out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+
+  for (const auto& track : tracks_) {
+    out << (first ? "" : ",\n")
+        << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << track->id
+        << ", \"args\": {\"name\": ";
+    writeJsonString(out, track->name);
+    out << "}}";
+    first = false;
+
+    int64 lastEnd = 0;
+    for (const Chunk* chunk = track->head.get();
+         chunk != nullptr;
+         chunk = chunk->next.load(std::memory_order_acquire)) {
+      uint32 count = chunk->count.load(std::memory_order_acquire);
+
+      for (uint32 i = 0; i < count; i++) {
+        const Event& e = chunk->events[i];
+        out << ",\n{\"name\": ";
+        writeJsonString(out, e.name);
+        out << ", \"ph\": \"X\", \"pid\": 1, \"tid\": " << track->id
+            << ", \"ts\": " << e.begin_ns / 1000.0
+            << ", \"dur\": " << (e.end_ns - e.begin_ns) / 1000.0
+            << ", \"args\": {\"depth\": " << e.depth << "}}";
+        lastEnd = e.end_ns;
+      }
+    }
+
+    // a full track stops recording, mark where its trace got cut off
+    uint64 dropped = track->dropped.load(std::memory_order_relaxed);
+    if (dropped > 0) {
+      out << ",\n{\"name\": \"Dropped events\", \"ph\": \"i\", \"s\": \"t\", "
+          << "\"pid\": 1, \"tid\": " << track->id << ", \"ts\": " << lastEnd / 1000.0
+          << ", \"args\": {\"dropped\": " << dropped << "}}";
+    }
+  }
+
+  out << "\n]}\n";
+  return out.good();
+}
+
+}
@@ -0,0 +1,124 @@
+#ifndef BELLUM_PROFILER_H
+#define BELLUM_PROFILER_H
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include "../common.h"
+
+// Scoped instrumentation, compiled out unless BELLUM_PROFILE is defined. Scope names must be
+// string literals or otherwise outlive the profiler.
+#ifdef BELLUM_PROFILE
+#define BELLUM_PROFILE_CONCAT_(a, b) a##b
+#define BELLUM_PROFILE_CONCAT(a, b) BELLUM_PROFILE_CONCAT_(a, b)
+#define BELLUM_PROFILE_SCOPE(name) \
+  ::bellum::ProfileScope BELLUM_PROFILE_CONCAT(profile_scope_, __LINE__){name}
+#else
+#define BELLUM_PROFILE_SCOPE(name) do {} while (false)
+#endif
+
+namespace bellum {
+
+class Profiler {
+public:
+  struct Event {
+    const char* name;
+    int64 begin_ns;
+    int64 end_ns;
+    uint32 depth;
+  };
+
+  // Timeline of events shown as one row in the trace, either a thread or a virtual track
+  struct Track;
+
+  static inline bool enabled() {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  static void setEnabled(bool enabled);
+  static void setThreadName(const std::string& name);
+
+  // Monotonic timestamp in nanoseconds, usable from any thread
+  static int64 now();
+
+  // Virtual tracks hold events that were not measured on the calling thread, such as GPU
+  // timings. Each track must only be written to from a single thread.
+  static Track* makeTrack(const std::string& name);
+  static void record(Track* track, const char* name, int64 begin, int64 end, uint32 depth);
+
+  // Writes all recorded events in the Chrome trace event format (about:tracing, Perfetto)
+  static bool exportChromeTrace(const std::string& path);
+
+private:
+  friend class ProfileScope;
+
+  static constexpr uint32 kChunkSize = 16384;
+  static constexpr uint32 kMaxChunks = 64;
+
+  // Events are only appended by the owning thread and published through 'count', so the
+  // exporter can read them without stopping the writer.
+  struct Chunk {
+    std::array<Event, kChunkSize> events;
+    std::atomic<uint32> count{0};
+    std::atomic<Chunk*> next{nullptr};
+
+    ~Chunk() {
+      delete next.load();
+    }
+  };
+
+  Profiler() {}
+
+  static inline uint32 beginScope();
+
+  static void endScope(const char* name, int64 begin, uint32 depth);
+  static void append(Track* track, const Event& event);
+  static Track* threadTrack();
+
+  static std::atomic<bool> enabled_;
+  static std::mutex tracks_mutex_;
+  static std::vector<std::unique_ptr<Track>> tracks_;
+};
+
+struct Profiler::Track {
+  uint32 id;
+  std::string name;
+  uint32 depth = 0;
+  uint32 chunk_count = 1;
+  // events past kMaxChunks, read by the exporting thread
+  std::atomic<uint64> dropped{0};
+  std::unique_ptr<Chunk> head;
+  Chunk* tail;
+};
+
+inline uint32 Profiler::beginScope() {
+  return threadTrack()->depth++;
+}
+
+class ProfileScope {
+public:
+  explicit inline ProfileScope(const char* name)
+    : name_(name), begin_(-1) {
+    if (Profiler::enabled()) {
+      depth_ = Profiler::beginScope();
+      begin_ = Profiler::now();
+    }
+  }
+
+  inline ~ProfileScope() {
+    if (begin_ >= 0) {
+      Profiler::endScope(name_, begin_, depth_);
+    }
+  }
+
+  DELETE_COPY_AND_ASSIGN(ProfileScope);
+
+private:
+  const char* name_;
+  int64 begin_;
+  uint32 depth_;
+};
+
+}
+
+#endif
@@ -0,0 +1,188 @@
+#include "random.h"
+#include <algorithm>
+#include <cstring>
+
+#include "math/simd.h"
+
+namespace bellum {
+
+std::atomic<uint64> Random::seed_{0x9E3779B97F4A7C15ull};
+std::atomic<uint32> Random::generation_{0};
+std::atomic<uint32> Random::next_stream_{0};
+
+namespace {
+
+inline uint64 splitMix64(uint64& state) {
+  uint64 z = (state += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+// Four xoshiro128+ generators side by side, lane i of each word belongs to generator i. Only
+// the upper bits of xoshiro128+ are used, which is all a float needs.
+struct BatchState {
+  alignas(16) uint32 s0[4];
+  alignas(16) uint32 s1[4];
+  alignas(16) uint32 s2[4];
+  alignas(16) uint32 s3[4];
+
+  explicit BatchState(RandomGenerator& generator) {
+    for (uint32 lane = 0; lane < 4; lane++) {
+      uint64 a = generator.next();
+      uint64 b = generator.next();
+      s0[lane] = static_cast<uint32>(a);
+      s1[lane] = static_cast<uint32>(a >> 32);
+      s2[lane] = static_cast<uint32>(b);
+      // an all zero state would only ever produce zeros
+      s3[lane] = static_cast<uint32>(b >> 32) | 1u;
+    }
+  }
+
+  // Writes four floats in [0, 1)
+  inline void next4(float* out) {
+#ifdef BELLUM_SIMD_SSE
+    __m128i a = _mm_load_si128(reinterpret_cast<const __m128i*>(s0));
+    __m128i b = _mm_load_si128(reinterpret_cast<const __m128i*>(s1));
+    __m128i c = _mm_load_si128(reinterpret_cast<const __m128i*>(s2));
+    __m128i d = _mm_load_si128(reinterpret_cast<const __m128i*>(s3));
+
+    __m128i result = _mm_add_epi32(a, d);
+    __m128i t = _mm_slli_epi32(b, 9);
+    c = _mm_xor_si128(c, a);
+    d = _mm_xor_si128(d, b);
+    b = _mm_xor_si128(b, c);
+    a = _mm_xor_si128(a, d);
+    c = _mm_xor_si128(c, t);
+    d = _mm_or_si128(_mm_slli_epi32(d, 11), _mm_srli_epi32(d, 21));
+
+    _mm_store_si128(reinterpret_cast<__m128i*>(s0), a);
+    _mm_store_si128(reinterpret_cast<__m128i*>(s1), b);
+    _mm_store_si128(reinterpret_cast<__m128i*>(s2), c);
+    _mm_store_si128(reinterpret_cast<__m128i*>(s3), d);
+
+    // top 24 bits as an exact float, scaled into [0, 1)
+    __m128 values = _mm_cvtepi32_ps(_mm_srli_epi32(result, 8));
+    _mm_storeu_ps(out, _mm_mul_ps(values, _mm_set1_ps(1.0f / 16777216.0f)));
+#else
+    for (uint32 lane = 0; lane < 4; lane++) {
+      uint32 result = s0[lane] + s3[lane];
+      uint32 t = s1[lane] << 9;
+      s2[lane] ^= s0[lane];
+      s3[lane] ^= s1[lane];
+      s1[lane] ^= s2[lane];
+      s0[lane] ^= s3[lane];
+      s2[lane] ^= t;
+      s3[lane] = (s3[lane] << 11) | (s3[lane] >> 21);
+      out[lane] = static_cast<float>(result >> 8) * (1.0f / 16777216.0f);
+    }
+#endif
+  }
+};
+
+// Size of the intermediate buffer when filling structs
+constexpr size_t kBatchChunk = 240;
+
+}
+
+void RandomGenerator::setSeed(uint64 seed) {
+  for (auto& word : state_) {
+    word = splitMix64(seed);
+  }
+}
+
+void RandomGenerator::jump() {
+  static constexpr uint64 kJump[] = {
+    0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull
+  };
+
+  std::array<uint64, 4> jumped{};
+  for (uint64 word : kJump) {
+    for (int32 bit = 0; bit < 64; bit++) {
+      if (word & (1ull << bit)) {
+        for (uint32 i = 0; i < 4; i++) {
+          jumped[i] ^= state_[i];
+        }
+      }
+      next();
+    }
+  }
+
+  state_ = jumped;
+}
+
+void RandomGenerator::fill(float* values, size_t count) {
+  BatchState batch{*this};
+
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    batch.next4(values + i);
+  }
+
+  if (i < count) {
+    float rest[4];
+    batch.next4(rest);
+    std::memcpy(values + i, rest, (count - i) * sizeof(float));
+  }
+}
+
+void RandomGenerator::fill(Vector3* values, size_t count) {
+  float buffer[kBatchChunk];
+
+  for (size_t i = 0; i < count; i += kBatchChunk / 3) {
+    size_t chunk = std::min(count - i, kBatchChunk / 3);
+    fill(buffer, chunk * 3);
+    for (size_t j = 0; j < chunk; j++) {
+      values[i + j] = Vector3{buffer[j * 3], buffer[j * 3 + 1], buffer[j * 3 + 2]};
+    }
+  }
+}
+
+void RandomGenerator::fill(Color* values, size_t count) {
+  float buffer[kBatchChunk];
+
+  for (size_t i = 0; i < count; i += kBatchChunk / 3) {
+    size_t chunk = std::min(count - i, kBatchChunk / 3);
+    fill(buffer, chunk * 3);
+    for (size_t j = 0; j < chunk; j++) {
+      values[i + j] = Color{buffer[j * 3], buffer[j * 3 + 1], buffer[j * 3 + 2], 1.0f};
+    }
+  }
+}
+
+RandomGenerator RandomGenerator::stream(uint64 seed, uint32 index) {
+  RandomGenerator generator{seed};
+  for (uint32 i = 0; i < index; i++) {
+    generator.jump();
+  }
+  return generator;
+}
+
+void Random::seed(uint64 seed) {
+  seed_.store(seed, std::memory_order_release);
+  generation_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+RandomGenerator& Random::generator() {
+  struct ThreadStream {
+    RandomGenerator generator;
+    uint32 index;
+    uint32 generation;
+
+    ThreadStream()
+      : index(next_stream_.fetch_add(1, std::memory_order_relaxed)),
+        generation(generation_.load(std::memory_order_acquire) - 1) {}
+  };
+  static thread_local ThreadStream stream;
+
+  // reseed lazily after Random::seed
+  uint32 generation = generation_.load(std::memory_order_acquire);
+  if (stream.generation != generation) {
+    stream.generator = RandomGenerator::stream(currentSeed(), stream.index);
+    stream.generation = generation;
+  }
+
+  return stream.generator;
+}
+
+}
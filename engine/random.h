@@ -1,25 +1,128 @@
 #ifndef __BELLUM_RANDOM_H__
 #define __BELLUM_RANDOM_H__
 
+#include <array>
+#include <atomic>
 #include "common.h"
 #include "color.h"
+#include "math/vector3.h"
 
 namespace bellum {
 
+// xoshiro256** generator. Equal seeds produce equal sequences on every platform, independent
+// streams come from jump() or stream().
+class RandomGenerator {
+public:
+  explicit RandomGenerator(uint64 seed = 0) {
+    setSeed(seed);
+  }
+
+  // Expands the seed into the full state with splitmix64
+  void setSeed(uint64 seed);
+
+  inline uint64 next();
+
+  // Uniform in [0, 1)
+  inline float value();
+  inline float range(float min, float max);
+  // Uniform in [min, max)
+  inline int32 range(int32 min, int32 max);
+  inline Color color();
+
+  // Equivalent to 2^128 calls to next(), generators jumped a different number of times never
+  // overlap in practice
+  void jump();
+
+  // Batch versions of value() and color(), vector components are uniform in [0, 1). Batches
+  // are generated four lanes at a time and yield a different sequence than single calls.
+  void fill(float* values, size_t count);
+  void fill(Vector3* values, size_t count);
+  void fill(Color* values, size_t count);
+
+  // The 'index'th independent stream of 'seed', e.g. one per thread or per world
+  static RandomGenerator stream(uint64 seed, uint32 index);
+
+private:
+  std::array<uint64, 4> state_;
+
+  static inline uint64 rotl(uint64 x, int32 k) {
+    return (x << k) | (x >> (64 - k));
+  }
+};
+
+// Convenience access to a generator per thread. Every thread draws from its own stream of the
+// global seed, streams are handed out in the order threads first use Random.
 class Random {
 public:
+  static void seed(uint64 seed);
+
+  static inline uint64 currentSeed() {
+    return seed_.load(std::memory_order_acquire);
+  }
+
+  // Generator of the calling thread
+  static RandomGenerator& generator();
+
   static float value() {
-    return static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+    return generator().value();
+  }
+
+  static float range(float min, float max) {
+    return generator().range(min, max);
+  }
+
+  static int32 range(int32 min, int32 max) {
+    return generator().range(min, max);
   }
 
   static Color color() {
-    return {value(), value(), value(), 1.0f};
+    return generator().color();
   }
 
 private:
   Random(){};
+
+  static std::atomic<uint64> seed_;
+  static std::atomic<uint32> generation_;
+  static std::atomic<uint32> next_stream_;
 };
 
+inline uint64 RandomGenerator::next() {
+  uint64 result = rotl(state_[1] * 5, 7) * 9;
+  uint64 t = state_[1] << 17;
+
+  state_[2] ^= state_[0];
+  state_[3] ^= state_[1];
+  state_[1] ^= state_[2];
+  state_[0] ^= state_[3];
+  state_[2] ^= t;
+  state_[3] = rotl(state_[3], 45);
+
+  return result;
+}
+
+inline float RandomGenerator::value() {
+  // top 24 bits fill the float mantissa exactly
+  return static_cast<float>(next() >> 40) * (1.0f / 16777216.0f);
+}
+
+inline float RandomGenerator::range(float min, float max) {
+  return min + (max - min) * value();
+}
+
+inline int32 RandomGenerator::range(int32 min, int32 max) {
+  // multiply-shift maps onto the span without a division
+  uint64 span = static_cast<uint64>(static_cast<int64>(max) - min);
+  return static_cast<int32>(min + static_cast<int64>(((next() >> 32) * span) >> 32));
+}
+
+inline Color RandomGenerator::color() {
+  float r = value();
+  float g = value();
+  float b = value();
+  return {r, g, b, 1.0f};
+}
+
 }
 
 #endif
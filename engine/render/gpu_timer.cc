@@ -0,0 +1,161 @@
+#include "gpu_timer.h"
+#ifndef BELLUM_HEADLESS
+#include <GL/glew.h>
+#endif
+
+namespace bellum {
+
+namespace {
+
+constexpr uint32 kNoScope = static_cast<uint32>(-1);
+
+}
+
+GpuTimer::GpuTimer()
+  : supported_(false),
+    active_(false),
+    frame_index_(0),
+    depth_(0),
+    last_frame_ms_(-1.0f),
+    track_(nullptr) {
+  for (auto& frame : frames_) {
+    frame.count = 0;
+    frame.clock_offset = 0;
+  }
+}
+
+#ifndef BELLUM_HEADLESS
+
+void GpuTimer::init() {
+  supported_ = GLEW_VERSION_3_3 || GLEW_ARB_timer_query;
+  if (!supported_) {
+    return;
+  }
+
+  for (auto& frame : frames_) {
+    glGenQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+  }
+}
+
+void GpuTimer::dispose() {
+  if (!supported_) {
+    return;
+  }
+
+  for (auto& frame : frames_) {
+    glDeleteQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+    frame.count = 0;
+  }
+  supported_ = false;
+  active_ = false;
+}
+
+void GpuTimer::beginFrame() {
+  active_ = supported_ && Profiler::enabled();
+  if (!supported_) {
+    return;
+  }
+
+  // the slot about to be reused holds the frame recorded kFrameLatency frames ago
+  frame_index_ = (frame_index_ + 1) % kFrameLatency;
+  Frame& frame = frames_[frame_index_];
+  resolve(frame);
+
+  frame.count = 0;
+  open_.clear();
+  depth_ = 0;
+
+  if (active_) {
+    GLint64 gpuNow;
+    glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+    frame.clock_offset = Profiler::now() - gpuNow;
+  }
+}
+
+void GpuTimer::begin(const char* name) {
+  Frame& frame = frames_[frame_index_];
+
+  if (!active_ || frame.count == kMaxScopes) {
+    open_.push_back(kNoScope);
+    return;
+  }
+
+  uint32 i = frame.count++;
+  frame.scopes[i] = Scope{name, depth_++, false};
+  glQueryCounter(frame.queries[i * 2], GL_TIMESTAMP);
+  open_.push_back(i);
+}
+
+void GpuTimer::end() {
+  if (open_.empty()) {
+    return;
+  }
+
+  uint32 i = open_.back();
+  open_.pop_back();
+  if (i == kNoScope) {
+    return;
+  }
+
+  Frame& frame = frames_[frame_index_];
+  glQueryCounter(frame.queries[i * 2 + 1], GL_TIMESTAMP);
+  frame.scopes[i].closed = true;
+  depth_--;
+}
+
+void GpuTimer::resolve(Frame& frame) {
+  if (frame.count == 0) {
+    return;
+  }
+
+  // never wait on the driver, drop the frame instead if it isn't finished yet
+  for (uint32 i = 0; i < frame.count; i++) {
+    if (!frame.scopes[i].closed) {
+      return;
+    }
+
+    GLint available = GL_FALSE;
+    glGetQueryObjectiv(frame.queries[i * 2 + 1], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (available == GL_FALSE) {
+      return;
+    }
+  }
+
+  if (track_ == nullptr) {
+    track_ = Profiler::makeTrack("GPU");
+  }
+
+  int64 total = 0;
+  for (uint32 i = 0; i < frame.count; i++) {
+    GLuint64 begin, end;
+    glGetQueryObjectui64v(frame.queries[i * 2], GL_QUERY_RESULT, &begin);
+    glGetQueryObjectui64v(frame.queries[i * 2 + 1], GL_QUERY_RESULT, &end);
+
+    const Scope& scope = frame.scopes[i];
+    Profiler::record(track_,
+                     scope.name,
+                     static_cast<int64>(begin) + frame.clock_offset,
+                     static_cast<int64>(end) + frame.clock_offset,
+                     scope.depth);
+
+    if (scope.depth == 0) {
+      total += static_cast<int64>(end - begin);
+    }
+  }
+
+  last_frame_ms_ = static_cast<float>(total / 1000000.0);
+}
+
+#else
+
+// Headless builds have no GL context, the timer stays unsupported and records nothing
+void GpuTimer::init() {}
+void GpuTimer::dispose() {}
+void GpuTimer::beginFrame() {}
+void GpuTimer::begin(const char* name) {}
+void GpuTimer::end() {}
+void GpuTimer::resolve(Frame& frame) {}
+
+#endif
+
+}
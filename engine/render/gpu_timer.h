@@ -0,0 +1,90 @@
+#ifndef BELLUM_GPU_TIMER_H
+#define BELLUM_GPU_TIMER_H
+
+#include <array>
+#include "../common.h"
+#include "../profiling/profiler.h"
+
+#ifdef BELLUM_PROFILE
+#define BELLUM_GPU_PROFILE_SCOPE(timer, name) \
+  ::bellum::GpuProfileScope BELLUM_PROFILE_CONCAT(gpu_profile_scope_, __LINE__){timer, name}
+#else
+#define BELLUM_GPU_PROFILE_SCOPE(timer, name) do {} while (false)
+#endif
+
+namespace bellum {
+
+// Measures GPU time of nested scopes with timestamp queries. Results are read back
+// kFrameLatency frames later, when they are available without stalling the pipeline, and are
+// written to a 'GPU' track of the profiler.
+class GpuTimer {
+public:
+  static constexpr uint32 kFrameLatency = 4;
+  static constexpr uint32 kMaxScopes = 64;
+
+  GpuTimer();
+  DELETE_COPY_AND_ASSIGN(GpuTimer);
+
+  // Requires a current GL context
+  void init();
+  void dispose();
+
+  void beginFrame();
+  void begin(const char* name);
+  void end();
+
+  inline bool supported() const {
+    return supported_;
+  }
+
+  // GPU time of the most recently resolved frame, or a negative value if there is none
+  inline float lastFrameMs() const {
+    return last_frame_ms_;
+  }
+
+private:
+  struct Scope {
+    const char* name;
+    uint32 depth;
+    bool closed;
+  };
+
+  struct Frame {
+    std::array<uint32, kMaxScopes * 2> queries;
+    std::array<Scope, kMaxScopes> scopes;
+    uint32 count;
+    int64 clock_offset;
+  };
+
+  void resolve(Frame& frame);
+
+  bool supported_;
+  bool active_;
+  uint32 frame_index_;
+  uint32 depth_;
+  std::array<Frame, kFrameLatency> frames_;
+  std::vector<uint32> open_;
+  float last_frame_ms_;
+  Profiler::Track* track_;
+};
+
+class GpuProfileScope {
+public:
+  inline GpuProfileScope(GpuTimer& timer, const char* name)
+    : timer_(timer) {
+    timer_.begin(name);
+  }
+
+  inline ~GpuProfileScope() {
+    timer_.end();
+  }
+
+  DELETE_COPY_AND_ASSIGN(GpuProfileScope);
+
+private:
+  GpuTimer& timer_;
+};
+
+}
+
+#endif
@@ -3,26 +3,41 @@
 #include "../components/renderer.h"
 #include "../resources/shader.h"
 #include "../resources/mesh.h"
+#ifndef BELLUM_HEADLESS
 #include <GL/glew.h>
+#endif
 #include "../components/camera.h"
 #include "../timing.h"
+#include "../profiling/profiler.h"
+#include "render_stats.h"
 
 namespace bellum {
 
 void RenderModule::onStart(Scene* scene) {
   scene_ = scene;
+  gpu_timer_.init();
+}
+
+void RenderModule::onExit() {
+  gpu_timer_.dispose();
 }
 
 void RenderModule::render() {
+  BELLUM_PROFILE_SCOPE("RenderModule::render");
+  gpu_timer_.beginFrame();
+  BELLUM_GPU_PROFILE_SCOPE(gpu_timer_, "RenderModule::render");
+
   Camera* camera = Camera::current();
-  Color clearColor = camera->clearColor();
-  Matrix4 view = camera->view();
+  Affine3 view = camera->view();
   Matrix4 projection = camera->projection();
 
   render_state.clear();
   render_state.projection = projection;
   render_state.view_projection = projection * view;
 
+#ifndef BELLUM_HEADLESS
+  Color clearColor = camera->clearColor();
+
   //glFrontFace(GL_CW);
   //glCullFace(GL_BACK);
   //glEnable(GL_CULL_FACE);
@@ -40,30 +55,75 @@ void RenderModule::render() {
       glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
       break;
   }
+#endif
+
+  FrameVector<DrawCommand> commands;
+  prepareDraws(commands);
+#ifndef BELLUM_HEADLESS
+  ambientPass(commands);
+#endif
 
-  ambientPass();
+  RenderStats::endFrame();
 }
 
-void RenderModule::ambientPass() {
+void RenderModule::prepareDraws(FrameVector<DrawCommand>& commands) {
+  BELLUM_PROFILE_SCOPE("RenderModule::prepareDraws");
+
+  commands.reserve(renderers_.size());
   for (auto renderer : renderers_) {
     if (renderer->enabled()) {
-      render_state.renderer = renderer;
-      Material material = renderer->material();
+      Affine3 model = renderer->node()->transform().localToWorld();
+      commands.push_back({renderer,
+                          renderer->material().shader.get(),
+                          render_state.view_projection * model});
+    }
+  }
+
+  // there is no culling yet, every disabled renderer counts as culled
+  RenderStats::add(RenderStats::Counter::VISIBLE_RENDERERS, commands.size());
+  RenderStats::add(RenderStats::Counter::CULLED_RENDERERS, renderers_.size() - commands.size());
+}
 
-      material.shader->bind();
-      Matrix4 model = renderer->node()->transform().localToWorld();
-      Matrix4 mvp = render_state.view_projection * model;
+#ifndef BELLUM_HEADLESS
+void RenderModule::ambientPass(const FrameVector<DrawCommand>& commands) {
+  BELLUM_PROFILE_SCOPE("RenderModule::ambientPass");
+  BELLUM_GPU_PROFILE_SCOPE(gpu_timer_, "RenderModule::ambientPass");
 
-      material.shader->setUniform("MVP", mvp);
+#ifdef BELLUM_PROFILE
+  // consecutive draws sharing a shader are timed as one draw group
+  Shader* group = nullptr;
+#endif
 
-      renderer->render();
+  for (const auto& command : commands) {
+    render_state.renderer = command.renderer;
 
-      material.shader->release();
-      glActiveTexture(GL_TEXTURE0);
-      glBindTexture(GL_TEXTURE_2D, 0);
+#ifdef BELLUM_PROFILE
+    if (command.shader != group) {
+      if (group != nullptr) {
+        gpu_timer_.end();
+      }
+      gpu_timer_.begin("Draw group");
+      group = command.shader;
     }
+#endif
+
+    command.shader->bind();
+    command.shader->setUniform("MVP", command.mvp);
+
+    command.renderer->render();
+
+    command.shader->release();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+  }
+
+#ifdef BELLUM_PROFILE
+  if (group != nullptr) {
+    gpu_timer_.end();
   }
+#endif
 }
+#endif
 
 void RenderModule::consolidate() {
   /*
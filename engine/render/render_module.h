@@ -4,11 +4,13 @@
 #include "../common.h"
 #include "../module.h"
 #include "../math/matrix4.h"
+#include "gpu_timer.h"
 
 namespace bellum {
 
 class Component;
 class Renderer;
+class Shader;
 
 class RenderModule : public Module {
 public:
@@ -17,11 +19,16 @@ public:
   RenderModule() {}
 
   void onStart(Scene* scene) override;
+  void onExit() override;
   void render() override;
   void consolidate();
 
   void addRenderer(Renderer* renderer);
 
+  const GpuTimer& gpuTimer() const {
+    return gpu_timer_;
+  }
+
 private:
   struct RenderState {
     Renderer* renderer;
@@ -33,9 +40,19 @@ private:
     }
   } render_state;
 
-  void ambientPass();
+  // What a single draw needs, built in frame memory before anything is submitted
+  struct DrawCommand {
+    Renderer* renderer;
+    Shader* shader;
+    Matrix4 mvp;
+  };
+
+  // Headless builds prepare draws and drop them, there is nothing to submit to
+  void prepareDraws(FrameVector<DrawCommand>& commands);
+  void ambientPass(const FrameVector<DrawCommand>& commands);
 
   std::vector<Renderer*> renderers_;
+  GpuTimer gpu_timer_;
 };
 
 }
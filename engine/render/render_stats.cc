@@ -0,0 +1,41 @@
+#include "render_stats.h"
+
+namespace bellum {
+
+RenderStats::Counters RenderStats::current_{};
+RenderStats::Counters RenderStats::last_{};
+
+void RenderStats::endFrame() {
+  last_ = current_;
+  current_.values.fill(0);
+}
+
+const char* RenderStats::counterName(Counter counter) {
+  switch (counter) {
+    case Counter::DRAW_CALLS:
+      return "draw_calls";
+    case Counter::INSTANCES:
+      return "instances";
+    case Counter::TRIANGLES:
+      return "triangles";
+    case Counter::VERTICES:
+      return "vertices";
+    case Counter::PROGRAM_BINDS:
+      return "program_binds";
+    case Counter::VAO_BINDS:
+      return "vao_binds";
+    case Counter::UNIFORM_UPLOADS:
+      return "uniform_uploads";
+    case Counter::BUFFER_BYTES_UPLOADED:
+      return "buffer_bytes_uploaded";
+    case Counter::VISIBLE_RENDERERS:
+      return "visible_renderers";
+    case Counter::CULLED_RENDERERS:
+      return "culled_renderers";
+    case Counter::COUNT:
+      break;
+  }
+  return "unknown";
+}
+
+}
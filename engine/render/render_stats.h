@@ -0,0 +1,64 @@
+#ifndef BELLUM_RENDER_STATS_H
+#define BELLUM_RENDER_STATS_H
+
+#include <array>
+#include "../common.h"
+
+namespace bellum {
+
+// Per-frame counters of the work submitted to GL, only touched from the render thread.
+class RenderStats {
+public:
+  enum class Counter : uint8 {
+    DRAW_CALLS,
+    INSTANCES,
+    TRIANGLES,
+    VERTICES,
+    PROGRAM_BINDS,
+    VAO_BINDS,
+    UNIFORM_UPLOADS,
+    BUFFER_BYTES_UPLOADED,
+    VISIBLE_RENDERERS,
+    CULLED_RENDERERS,
+    COUNT
+  };
+
+  struct Counters {
+    std::array<uint64, static_cast<size_t>(Counter::COUNT)> values;
+
+    inline uint64& operator[](Counter counter) {
+      return values[static_cast<size_t>(counter)];
+    }
+
+    inline uint64 operator[](Counter counter) const {
+      return values[static_cast<size_t>(counter)];
+    }
+  };
+
+  static inline void add(Counter counter, uint64 amount = 1) {
+    current_[counter] += amount;
+  }
+
+  // Counters of the frame being rendered
+  static inline const Counters& current() {
+    return current_;
+  }
+
+  // Counters of the last complete frame
+  static inline const Counters& last() {
+    return last_;
+  }
+
+  static void endFrame();
+  static const char* counterName(Counter counter);
+
+private:
+  RenderStats() {}
+
+  static Counters current_;
+  static Counters last_;
+};
+
+}
+
+#endif
@@ -2,30 +2,55 @@
 #define __BELLUM_MATERIAL_H__
 
 #include "../common.h"
+#include "shader_variants.h"
 
 namespace bellum {
 
 struct Shader;
 
+// Draws use 'shader'. A material made from variants picks it by keyword mask when the keywords
+// change, never while drawing.
 struct Material {
-  Shader* shader;
+  std::shared_ptr<Shader> shader;
+  std::shared_ptr<ShaderVariants> variants;
+  uint32 keywords;
 
   inline Material();
-  inline Material(Shader* shader);
+  inline Material(std::shared_ptr<Shader> shader);
+  inline Material(std::shared_ptr<ShaderVariants> variants, uint32 keywords = 0);
   inline Material(const Material& other);
   inline Material& operator=(const Material& other);
+
+  // Compiles the variant if it's the first to use it
+  inline void setKeywords(uint32 keywords);
 };
 
-Material::Material() {}
+Material::Material()
+  : keywords(0) {}
+
+Material::Material(std::shared_ptr<Shader> shader)
+  : shader(std::move(shader)), keywords(0) {}
 
-Material::Material(Shader* shader)
-  : shader(shader) {}
+Material::Material(std::shared_ptr<ShaderVariants> variants, uint32 keywords)
+  : variants(std::move(variants)), keywords(keywords) {
+  shader = this->variants->variant(keywords);
+}
 
 Material::Material(const Material& other)
-  : shader(other.shader) {}
+  : shader(other.shader), variants(other.variants), keywords(other.keywords) {}
 
 Material& Material::operator=(const Material& other) {
   shader = other.shader;
+  variants = other.variants;
+  keywords = other.keywords;
+  return *this;
+}
+
+void Material::setKeywords(uint32 keywords) {
+  this->keywords = keywords;
+  if (variants != nullptr) {
+    shader = variants->variant(keywords);
+  }
 }
 
 }
@@ -1,8 +1,13 @@
 #include "mesh.h"
+#ifndef BELLUM_HEADLESS
 #include <GL/glew.h>
+#endif
 
 #include "../color.h"
 #include "../math/vector2.h"
+#include "../math/batch.h"
+#include "../profiling/profiler.h"
+#include "../render/render_stats.h"
 
 namespace bellum {
 
@@ -13,13 +18,19 @@ Mesh::Mesh(BindingInfo bindingInfo, uint32 vaoId, uint32 vboId, uint32 iboId)
     ibo_id_(iboId),
     readable_(true),
     dynamic_(false),
-    triangle_count_(0) {}
+    triangle_count_(0),
+    vertex_count_(0),
+    cpu_bytes_(0),
+    gpu_bytes_(0) {}
 
 void Mesh::clear() {
-  colors_.clear();
-  vertices_.clear();
-  triangles_.clear();
-  uv_.clear();
+  // swap instead of clear so the storage is actually released
+  std::vector<Color>().swap(colors_);
+  std::vector<Vector3>().swap(normals_);
+  std::vector<Vector3>().swap(vertices_);
+  std::vector<Vector2>().swap(uv_);
+  std::vector<uint32>().swap(triangles_);
+  trackMemory();
 }
 
 void Mesh::markDynamic() {
@@ -31,43 +42,44 @@ void Mesh::recalculateBounds() {
     throw NotReadableException{};
   }
 
-  Vector3 v = vertices_[0];
-  Vector3 min = v, max = v;
-
-  for (int i = 1; i < vertices_.size(); i++) {
-    v = vertices_[i];
-    min = Vector3::min(min, v);
-    max = Vector3::max(max, v);
-  }
-
+  Vector3 min, max;
+  Batch::minMax(vertices_.data(), vertices_.size(), min, max);
   bounds_.setMinMax(min, max);
 }
 
 void Mesh::recalculateNormals() {
-  normals_.clear();
-  normals_.reserve(vertices_.size());
-  for (uint32 i = 0; i < vertices_.size(); i++) {
-    normals_.emplace_back();
+  normals_.assign(vertices_.size(), Vector3{});
+
+  // face normals from the triangle edges, computed in place over the first edge array
+  FrameAllocator::Scope scratch;
+  uint32 faceCount = triangles_.size() / 3;
+  Vector3* faces = FrameAllocator::allocateArray<Vector3>(faceCount);
+  Vector3* edges = FrameAllocator::allocateArray<Vector3>(faceCount);
+
+  for (uint32 f = 0; f < faceCount; f++) {
+    const Vector3& v1 = vertices_[triangles_[f * 3]];
+    faces[f] = vertices_[triangles_[f * 3 + 1]] - v1;
+    edges[f] = vertices_[triangles_[f * 3 + 2]] - v1;
   }
 
-  for (uint32 i = 0; i < triangles_.size(); i += 3) {
-    uint32 i1 = triangles_[i];
-    uint32 i2 = triangles_[i + 1];
-    uint32 i3 = triangles_[i + 2];
+  Batch::cross(faces, edges, faces, faceCount);
+  Batch::normalize(faces, faceCount);
 
-    Vector3 v1 = vertices_[i2] - vertices_[i1];
-    Vector3 v2 = vertices_[i3] - vertices_[i1];
+  // every vertex gets the average of the faces it's part of
+  for (uint32 f = 0; f < faceCount; f++) {
+    normals_[triangles_[f * 3]] += faces[f];
+    normals_[triangles_[f * 3 + 1]] += faces[f];
+    normals_[triangles_[f * 3 + 2]] += faces[f];
+  }
 
-    Vector3 normal = Vector3::cross(v1, v2).normalized();
+  Batch::normalize(normals_.data(), normals_.size());
 
-    normals_[i1] = (normals_[i1] + normal).normalized();
-    normals_[i2] = (normals_[i2] + normal).normalized();
-    normals_[i3] = (normals_[i3] + normal).normalized();
-    normals_[i1] = (normals_[i1] + normal).normalized();
-  }
+  trackMemory();
 }
 
 void Mesh::uploadMeshData(bool markNoLongerReadable) {
+  BELLUM_PROFILE_SCOPE("Mesh::uploadMeshData");
+
   if(binding_info_.has(AttributeKind::COLOR) && vertices_.size() != colors_.size()) {
     throw InvalidData{"Invalid color data length"};
   }
@@ -78,9 +90,10 @@ void Mesh::uploadMeshData(bool markNoLongerReadable) {
     throw InvalidData{"Invalid normal data length"};
   }
 
-  // create vertex buffer
+  // create vertex buffer, only needed until it's handed to GL
+  FrameAllocator::Scope scratch;
   uint32 bufferSize = vertices_.size() * binding_info_.size;
-  float* vb = new float[bufferSize];
+  float* vb = FrameAllocator::allocateArray<float>(bufferSize);
   uint32 j = 0;
 
   Vector3 v, n;
@@ -117,11 +130,13 @@ void Mesh::uploadMeshData(bool markNoLongerReadable) {
     }
   }
 
-  // upload buffers
+  vertex_count_ = vertices_.size();
+
+  // upload buffers, headless builds only build the vertex buffer
+#ifndef BELLUM_HEADLESS
   glBindVertexArray(vao_id_);
   glBindBuffer(GL_ARRAY_BUFFER, vbo_id_);
   glBufferData(GL_ARRAY_BUFFER, bufferSize * sizeof(float), vb, GL_STATIC_DRAW);
-  delete[](vb);
 
   uint32 offset = 0;
   for (const auto& ap : binding_info_.attribute_pointers) {
@@ -141,6 +156,13 @@ void Mesh::uploadMeshData(bool markNoLongerReadable) {
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo_id_);
   glBufferData(GL_ELEMENT_ARRAY_BUFFER, triangle_count_ * sizeof(uint32), (uint32*)(triangles_.data()), GL_STATIC_DRAW);
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+#endif
+
+  uint64 gpuBytes = bufferSize * sizeof(float) + triangle_count_ * sizeof(uint32);
+  RenderStats::add(RenderStats::Counter::BUFFER_BYTES_UPLOADED, gpuBytes);
+  MemoryTracker::freed(MemoryTracker::Tag::GPU_BUFFER, gpu_bytes_);
+  MemoryTracker::allocated(MemoryTracker::Tag::GPU_BUFFER, gpuBytes);
+  gpu_bytes_ = gpuBytes;
 
   if (markNoLongerReadable) {
     clear();
@@ -151,7 +173,9 @@ void Mesh::uploadMeshData(bool markNoLongerReadable) {
 }
 
 void Mesh::render() {
+#ifndef BELLUM_HEADLESS
   glBindVertexArray(vao_id_);
+  RenderStats::add(RenderStats::Counter::VAO_BINDS);
 
   for (const auto& ap : binding_info_.attribute_pointers) {
     glEnableVertexAttribArray(ap.location);
@@ -159,6 +183,10 @@ void Mesh::render() {
 
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo_id_);
   glDrawElements(GL_TRIANGLES, triangle_count_, GL_UNSIGNED_INT, nullptr);
+  RenderStats::add(RenderStats::Counter::DRAW_CALLS);
+  RenderStats::add(RenderStats::Counter::INSTANCES);
+  RenderStats::add(RenderStats::Counter::TRIANGLES, triangle_count_ / 3);
+  RenderStats::add(RenderStats::Counter::VERTICES, vertex_count_);
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
   for (const auto& ap : binding_info_.attribute_pointers) {
@@ -166,12 +194,34 @@ void Mesh::render() {
   }
 
   glBindVertexArray(0);
+#endif
 }
 
 void Mesh::dispose() {
+#ifndef BELLUM_HEADLESS
   glDeleteVertexArrays(1, &vao_id_);
   glDeleteBuffers(1, &vbo_id_);
   glDeleteBuffers(1, &ibo_id_);
+#endif
+
+  MemoryTracker::freed(MemoryTracker::Tag::GPU_BUFFER, gpu_bytes_);
+  gpu_bytes_ = 0;
+  clear();
+}
+
+void Mesh::trackMemory() {
+  uint64 bytes = colors_.capacity() * sizeof(Color) +
+                 normals_.capacity() * sizeof(Vector3) +
+                 vertices_.capacity() * sizeof(Vector3) +
+                 uv_.capacity() * sizeof(Vector2) +
+                 triangles_.capacity() * sizeof(uint32);
+
+  if (bytes > cpu_bytes_) {
+    MemoryTracker::allocated(MemoryTracker::Tag::MESH, bytes - cpu_bytes_);
+  } else {
+    MemoryTracker::freed(MemoryTracker::Tag::MESH, cpu_bytes_ - bytes);
+  }
+  cpu_bytes_ = bytes;
 }
 
 }
@@ -20,6 +20,8 @@ class Mesh : public Resource {
   DEFINE_EXCEPTION(InvalidData, "Invalid data");
 
 public:
+  BELLUM_TRACK_MEMORY(MESH)
+
   inline const Bounds& bounds() const;
   inline const std::vector<Color>& colors() const;
   inline void setColors(const std::vector<Color>& colors);
@@ -45,6 +47,10 @@ public:
   void recalculateNormals();
   void uploadMeshData(bool markNoLongerReadable = true);
 
+  uint64 gpuBytes() const override {
+    return gpu_bytes_;
+  }
+
 protected:
   void dispose() override;
 
@@ -52,6 +58,8 @@ private:
   Mesh(BindingInfo bindingInfo, uint32 vaoId, uint32 vboId, uint32 iboId);
 
   void render();
+  // reports changes in the size of the CPU-side arrays to the memory tracker
+  void trackMemory();
 
   Bounds bounds_;
   BindingInfo binding_info_;
@@ -62,10 +70,13 @@ private:
   std::vector<Vector2> uv_;
   std::vector<uint32> triangles_;
   uint32 triangle_count_;
+  uint32 vertex_count_;
   bool readable_;
   uint32 vao_id_;
   uint32 vbo_id_;
   uint32 ibo_id_;
+  uint64 cpu_bytes_;
+  uint64 gpu_bytes_;
 };
 
 inline const Bounds& Mesh::bounds() const {
@@ -81,6 +92,7 @@ inline const std::vector<Color>& Mesh::colors() const {
 
 inline void Mesh::setColors(const std::vector<Color>& colors) {
   colors_ = colors;
+  trackMemory();
 }
 
 template<uint32 count>
@@ -89,6 +101,7 @@ void Mesh::setColors(std::array<float, count> colors) {
   for (uint32 i = 0; i < count; i += 4) {
     colors_.push_back(Color{&colors[i]});
   }
+  trackMemory();
 }
 
 inline const std::vector<Vector3>& Mesh::normals() const {
@@ -100,6 +113,7 @@ inline const std::vector<Vector3>& Mesh::normals() const {
 
 inline void Mesh::setNormals(const std::vector<Vector3>& normals) {
   normals_ = normals;
+  trackMemory();
 }
 
 template<uint32 count>
@@ -108,6 +122,7 @@ void Mesh::setNormals(std::array<float, count> normals) {
   for (uint32 i = 0; i < count; i += 3) {
     normals_.push_back(Vector3{&normals[i]});
   }
+  trackMemory();
 }
 
 inline const std::vector<Vector3>& Mesh::vertices() const {
@@ -119,6 +134,7 @@ inline const std::vector<Vector3>& Mesh::vertices() const {
 
 inline void Mesh::setVertices(const std::vector<Vector3>& vertices) {
   vertices_ = vertices;
+  trackMemory();
 }
 
 template<uint32 count>
@@ -127,6 +143,7 @@ void Mesh::setVertices(std::array<float, count> vertices) {
   for (uint32 i = 0; i < count; i += 3) {
     vertices_.push_back(Vector3{&vertices[i]});
   }
+  trackMemory();
 }
 
 inline const std::vector<Vector2>& Mesh::uv() const {
@@ -138,6 +155,7 @@ inline const std::vector<Vector2>& Mesh::uv() const {
 
 inline void Mesh::setUv(const std::vector<Vector2>& uv) {
   uv_ = uv;
+  trackMemory();
 }
 
 inline const std::vector<uint32>& Mesh::triangles() const {
@@ -150,6 +168,7 @@ inline const std::vector<uint32>& Mesh::triangles() const {
 inline void Mesh::setTriangles(const std::vector<uint32>& triangles) {
   triangle_count_ = triangles.size();
   triangles_ = triangles;
+  trackMemory();
 }
 
 inline bool Mesh::readable() const {
@@ -0,0 +1,220 @@
+#include "program_cache.h"
+#include <cstdio>
+#include <fstream>
+#include "../application.h"
+
+#include <GL/glew.h>
+
+namespace bellum {
+
+constexpr uint32 ProgramCache::kMagic;
+constexpr uint32 ProgramCache::kVersion;
+
+bool ProgramCache::enabled_;
+bool ProgramCache::dirty_;
+std::string ProgramCache::path_;
+std::string ProgramCache::driver_;
+std::unordered_map<uint64, ProgramCache::Entry> ProgramCache::entries_;
+
+namespace {
+
+template<typename T>
+inline void put(std::ostream& out, const T& value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+inline bool get(std::istream& in, T& value) {
+  return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+// Bytes between the read position and the end of the file, 0 once the stream failed
+uint64 remaining(std::istream& in, uint64 fileSize) {
+  std::streamoff position = in.tellg();
+  if (position < 0 || static_cast<uint64>(position) > fileSize) {
+    return 0;
+  }
+  return fileSize - static_cast<uint64>(position);
+}
+
+std::string glString(GLenum name) {
+  auto value = reinterpret_cast<const char*>(glGetString(name));
+  return value != nullptr ? value : "";
+}
+
+}
+
+void ProgramCache::open(const std::string& path) {
+  Logger* logger = Application::instance()->logger();
+
+  int32 formats = 0;
+  if (GLEW_ARB_get_program_binary) {
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+  }
+  if (formats == 0) {
+    logger->warning("The driver can't return program binaries, shader cache disabled");
+    return;
+  }
+
+  enabled_ = true;
+  dirty_ = false;
+  path_ = path;
+  driver_ = driver();
+  entries_.clear();
+
+  if (read()) {
+    logger->info("Loaded ", entries_.size(), " shader programs from '", path_, "'");
+  } else {
+    // missing, from another driver or damaged, it gets written anew
+    entries_.clear();
+  }
+}
+
+void ProgramCache::close() {
+  if (!enabled_) {
+    return;
+  }
+
+  if (dirty_) {
+    if (write()) {
+      Application::instance()->logger()->info("Wrote ", entries_.size(),
+                                              " shader programs to '", path_, "'");
+    } else {
+      Application::instance()->logger()->error("Failed to write shader cache '", path_, "'");
+    }
+  }
+
+  enabled_ = false;
+  entries_.clear();
+}
+
+bool ProgramCache::load(uint64 key, uint32 program) {
+  if (!enabled_) {
+    return false;
+  }
+
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return false;
+  }
+
+  const Entry& entry = it->second;
+  glProgramBinary(program, entry.format, entry.binary.data(),
+                  static_cast<int32>(entry.binary.size()));
+
+  int32 success;
+  glGetProgramiv(program, GL_LINK_STATUS, &success);
+  if (success == GL_FALSE) {
+    entries_.erase(it);
+    dirty_ = true;
+    return false;
+  }
+
+  return true;
+}
+
+void ProgramCache::prepare(uint32 program) {
+  if (enabled_) {
+    glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
+}
+
+void ProgramCache::store(uint64 key, uint32 program) {
+  if (!enabled_) {
+    return;
+  }
+
+  int32 length = 0;
+  glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0) {
+    return;
+  }
+
+  Entry entry;
+  entry.binary.resize(static_cast<size_t>(length));
+  GLenum format;
+  glGetProgramBinary(program, length, nullptr, &format, entry.binary.data());
+  entry.format = format;
+
+  entries_[key] = std::move(entry);
+  dirty_ = true;
+}
+
+std::string ProgramCache::driver() {
+  return glString(GL_VENDOR) + '|' + glString(GL_RENDERER) + '|' + glString(GL_VERSION);
+}
+
+bool ProgramCache::read() {
+  std::ifstream in{path_, std::ios::binary | std::ios::ate};
+  if (!in.is_open()) {
+    return false;
+  }
+
+  // lengths are checked against what is left of the file, a corrupt one must not allocate
+  std::streamoff end = in.tellg();
+  if (end < 0 || !in.seekg(0)) {
+    return false;
+  }
+  uint64 fileSize = static_cast<uint64>(end);
+
+  uint32 magic, version, driverLength, count;
+  if (!get(in, magic) || !get(in, version) || magic != kMagic || version != kVersion ||
+      !get(in, driverLength) || driverLength > remaining(in, fileSize)) {
+    return false;
+  }
+
+  std::string driver(driverLength, '\0');
+  if (!in.read(&driver[0], driverLength) || driver != driver_ || !get(in, count)) {
+    return false;
+  }
+
+  for (uint32 i = 0; i < count; i++) {
+    uint64 key;
+    uint32 length;
+    Entry entry;
+    if (!get(in, key) || !get(in, entry.format) || !get(in, length) ||
+        length > remaining(in, fileSize)) {
+      return false;
+    }
+
+    entry.binary.resize(length);
+    if (!in.read(reinterpret_cast<char*>(entry.binary.data()), length)) {
+      return false;
+    }
+    entries_[key] = std::move(entry);
+  }
+
+  return true;
+}
+
+bool ProgramCache::write() {
+  // written next to the old file first so a crash never leaves half a cache behind
+  std::string temporary = path_ + ".tmp";
+  {
+    std::ofstream out{temporary, std::ios::binary | std::ios::trunc};
+    if (!out.is_open()) {
+      return false;
+    }
+
+    put(out, kMagic);
+    put(out, kVersion);
+    put(out, static_cast<uint32>(driver_.size()));
+    out.write(driver_.data(), driver_.size());
+    put(out, static_cast<uint32>(entries_.size()));
+    for (const auto& kv : entries_) {
+      put(out, kv.first);
+      put(out, kv.second.format);
+      put(out, static_cast<uint32>(kv.second.binary.size()));
+      out.write(reinterpret_cast<const char*>(kv.second.binary.data()), kv.second.binary.size());
+    }
+
+    if (!out.good()) {
+      return false;
+    }
+  }
+
+  std::remove(path_.c_str());
+  return std::rename(temporary.c_str(), path_.c_str()) == 0;
+}
+
+}
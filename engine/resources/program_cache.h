@@ -0,0 +1,56 @@
+#ifndef BELLUM_PROGRAM_CACHE_H
+#define BELLUM_PROGRAM_CACHE_H
+
+#include <unordered_map>
+#include "../common.h"
+
+namespace bellum {
+
+// Linked shader program binaries kept in one file between runs. The file belongs to the driver
+// that wrote it, after a driver change it is dropped as a whole. Single binaries the driver
+// rejects are dropped too, callers then compile from source and store the result again. Only
+// used on the GL thread.
+class ProgramCache {
+public:
+  // Reads the cache at 'path', needs a current GL context. Stays disabled without driver
+  // support for program binaries.
+  static void open(const std::string& path);
+  // Writes the cache back if anything was stored since open
+  static void close();
+
+  static bool enabled() {
+    return enabled_;
+  }
+
+  // Links 'program' from the binary stored under 'key', returns false if there is none or the
+  // driver rejected it
+  static bool load(uint64 key, uint32 program);
+  // Call before linking a program that is going to be stored
+  static void prepare(uint32 program);
+  static void store(uint64 key, uint32 program);
+
+private:
+  struct Entry {
+    uint32 format;
+    std::vector<uint8> binary;
+  };
+
+  static constexpr uint32 kMagic = 0x43504C42; // 'BLPC'
+  static constexpr uint32 kVersion = 1;
+
+  ProgramCache() {}
+
+  static std::string driver();
+  static bool read();
+  static bool write();
+
+  static bool enabled_;
+  static bool dirty_;
+  static std::string path_;
+  static std::string driver_;
+  static std::unordered_map<uint64, Entry> entries_;
+};
+
+}
+
+#endif
@@ -1,11 +1,26 @@
 #ifndef __BELLUM_RESOURCE_H__
 #define __BELLUM_RESOURCE_H__
 
+#include "../common/types.h"
+
 namespace bellum {
 
 class Resource {
   friend class ResourceLoader;
 
+public:
+  virtual ~Resource() {}
+
+  // Estimated driver memory held by the resource
+  virtual uint64 gpuBytes() const {
+    return 0;
+  }
+
+  // Estimated heap memory held by the resource itself
+  virtual uint64 cpuBytes() const {
+    return 0;
+  }
+
 protected:
   virtual void dispose() = 0;
 };
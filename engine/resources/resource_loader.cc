@@ -1,15 +1,30 @@
 #include <fstream>
 #include <sstream>
 #include "resource_loader.h"
+#include "program_cache.h"
 #include "shader.h"
+#include "shader_variants.h"
 #include "mesh.h"
+#include "../common/hash.h"
 #include "../application.h"
+#include "../timing.h"
+#include "../profiling/profiler.h"
 
 #include <GL/glew.h>
 
 namespace bellum {
 
 std::vector<std::unique_ptr<Resource>> ResourceLoader::resources_;
+std::unordered_map<std::string, ResourceLoader::CacheEntry> ResourceLoader::cache_;
+std::unordered_map<std::string, std::weak_ptr<ShaderVariants>> ResourceLoader::variant_sets_;
+ResourceLoader::CacheStats ResourceLoader::cache_stats_;
+uint64 ResourceLoader::cache_clock_;
+uint64 ResourceLoader::cache_cpu_budget_ = std::numeric_limits<uint64>::max();
+uint64 ResourceLoader::cache_gpu_budget_ = std::numeric_limits<uint64>::max();
+std::unique_ptr<ThreadPool> ResourceLoader::workers_;
+std::mutex ResourceLoader::pending_mutex_;
+std::deque<std::function<void()>> ResourceLoader::pending_;
+std::vector<ResourceLoader::CompilingShader> ResourceLoader::compiling_;
 std::string ResourceLoader::kParentDirectory  = "assets";
 
 std::string ResourceLoader::getAssetPath(const std::string& asset) {
@@ -33,39 +48,201 @@ Mesh* ResourceLoader::makeEmptyMesh(const BindingInfo& bindingInfo) {
   resources_.emplace_back(new Mesh{bindingInfo, vaoId, vboId, iboId});
   return dynamic_cast<Mesh*>(resources_.back().get());}
 
-Shader* ResourceLoader::loadShader(const std::string& vertexShaderAsset,
-                                   const std::string& fragmentShaderAsset,
-                                   const BindingInfo& bindingInfo,
-                                   const std::vector<std::string>& uniformNames) {
-  Shader::UniformMap uniforms;
-  for (auto& name : uniformNames) {
-    uniforms.insert(std::make_pair(name, Shader::Uniform{name, -1}));
-  }
+std::shared_ptr<Shader> ResourceLoader::loadShader(const std::string& vertexShaderAsset,
+                                                   const std::string& fragmentShaderAsset,
+                                                   const BindingInfo& bindingInfo,
+                                                   const std::vector<std::string>& uniformNames) {
+  BELLUM_PROFILE_SCOPE("ResourceLoader::loadShader");
 
-  uint32 program = glCreateProgram();
-  if (program == 0) {
-    throw Shader::CreateException{};
+  std::string key = shaderKey(vertexShaderAsset, fragmentShaderAsset, bindingInfo, uniformNames);
+  std::shared_ptr<Resource> cached = findCached(key);
+  if (cached != nullptr) {
+    return std::static_pointer_cast<Shader>(cached);
   }
 
   std::string vs = loadTextAsset(vertexShaderAsset);
   std::string fs = loadTextAsset(fragmentShaderAsset);
 
-  compileShader(vs, GL_VERTEX_SHADER, program);
-  compileShader(fs, GL_FRAGMENT_SHADER, program);
+  std::shared_ptr<Shader> shader{finishShader(
+    beginShader(vertexShaderAsset, vs, fragmentShaderAsset, fs, bindingInfo, uniformNames))};
+  addToCache(key, shader);
+  return shader;
+}
+
+std::shared_ptr<ShaderVariants> ResourceLoader::loadShaderVariants(
+  const std::string& vertexShaderAsset,
+  const std::string& fragmentShaderAsset,
+  const BindingInfo& bindingInfo,
+  const std::vector<std::string>& uniformNames) {
+  BELLUM_PROFILE_SCOPE("ResourceLoader::loadShaderVariants");
+
+  std::string key = shaderKey(vertexShaderAsset, fragmentShaderAsset, bindingInfo, uniformNames);
+  std::shared_ptr<ShaderVariants> variants = variant_sets_[key].lock();
+  if (variants != nullptr) {
+    return variants;
+  }
+
+  variants.reset(new ShaderVariants{vertexShaderAsset, loadTextAsset(vertexShaderAsset),
+                                    fragmentShaderAsset, loadTextAsset(fragmentShaderAsset),
+                                    bindingInfo, uniformNames});
+  variant_sets_[key] = variants;
+  return variants;
+}
+
+std::shared_ptr<Shader> ResourceLoader::loadShaderVariant(const ShaderVariants& variants,
+                                                          uint32 mask) {
+  BELLUM_PROFILE_SCOPE("ResourceLoader::loadShaderVariant");
+
+  std::string key = shaderKey(variants.vertex_asset_, variants.fragment_asset_,
+                              variants.binding_info_, variants.uniform_names_) +
+                    '#' + std::to_string(mask);
+  std::shared_ptr<Resource> cached = findCached(key);
+  if (cached != nullptr) {
+    return std::static_pointer_cast<Shader>(cached);
+  }
+
+  std::shared_ptr<Shader> shader{finishShader(beginShader(
+    variants.vertex_asset_, variants.variantSource(variants.vertex_source_, mask),
+    variants.fragment_asset_, variants.variantSource(variants.fragment_source_, mask),
+    variants.binding_info_, variants.uniform_names_, false))};
+  addToCache(key, shader);
+  return shader;
+}
+
+std::future<std::shared_ptr<Shader>> ResourceLoader::loadShaderAsync(
+  const std::string& vertexShaderAsset,
+  const std::string& fragmentShaderAsset,
+  const BindingInfo& bindingInfo,
+  const std::vector<std::string>& uniformNames) {
+  auto promise = std::make_shared<std::promise<std::shared_ptr<Shader>>>();
+  std::future<std::shared_ptr<Shader>> result = promise->get_future();
+
+  std::string key = shaderKey(vertexShaderAsset, fragmentShaderAsset, bindingInfo, uniformNames);
+  std::shared_ptr<Resource> cached = findCached(key);
+  if (cached != nullptr) {
+    promise->set_value(std::static_pointer_cast<Shader>(cached));
+    return result;
+  }
+
+  workers().submit([=]() {
+    std::string vs, fs;
+    try {
+      vs = loadTextAsset(vertexShaderAsset);
+      fs = loadTextAsset(fragmentShaderAsset);
+    } catch (...) {
+      promise->set_exception(std::current_exception());
+      return;
+    }
+
+    queueFinalization([=]() {
+      try {
+        // an earlier load of the same shader may have finished in the meantime, this one
+        // already counted as a miss
+        auto it = cache_.find(key);
+        if (it != cache_.end()) {
+          it->second.last_used = ++cache_clock_;
+          promise->set_value(std::static_pointer_cast<Shader>(it->second.resource));
+          return;
+        }
+
+        compiling_.push_back({beginShader(vertexShaderAsset, vs, fragmentShaderAsset, fs,
+                                          bindingInfo, uniformNames),
+                              key, promise});
+      } catch (...) {
+        promise->set_exception(std::current_exception());
+      }
+    });
+  });
+
+  return result;
+}
+
+ResourceLoader::PendingShader ResourceLoader::beginShader(
+  const std::string& vertexShaderAsset,
+  const std::string& vertexShaderSource,
+  const std::string& fragmentShaderAsset,
+  const std::string& fragmentShaderSource,
+  const BindingInfo& bindingInfo,
+  const std::vector<std::string>& uniformNames,
+  bool requireUniforms) {
+  BELLUM_PROFILE_SCOPE("ResourceLoader::beginShader");
+
+  PendingShader pending{vertexShaderAsset, fragmentShaderAsset, uniformNames, requireUniforms, 0,
+                        0, 0, 0};
+  pending.program = glCreateProgram();
+  if (pending.program == 0) {
+    throw Shader::CreateException{};
+  }
+
+  // attribute locations are baked into the binary, they are part of the key
+  uint64 key = Hash::fnv1a(vertexShaderSource);
+  key = Hash::fnv1a("", 1, key);
+  key = Hash::fnv1a(fragmentShaderSource, key);
+  for (auto& ap : bindingInfo.attribute_pointers) {
+    key = Hash::fnv1a(&ap.kind, sizeof(ap.kind), key);
+    key = Hash::fnv1a(&ap.location, sizeof(ap.location), key);
+  }
+  pending.binary_key = key;
+
+  if (ProgramCache::load(key, pending.program)) {
+    return pending;
+  }
+
+  pending.vertex_shader = compileShader(vertexShaderSource, GL_VERTEX_SHADER, pending.program);
+  pending.fragment_shader =
+    compileShader(fragmentShaderSource, GL_FRAGMENT_SHADER, pending.program);
 
   // bind attributes
   for (auto& ap : bindingInfo.attribute_pointers) {
-    glBindAttribLocation(program, ap.location, AttributeKindUtil::getName(ap.kind));
+    glBindAttribLocation(pending.program, ap.location, AttributeKindUtil::getName(ap.kind));
     GL_CHECK();
   }
 
-  linkShaderProgram(program);
+  // linking right after compiling is fine, a failed compile shows up as a failed link
+  ProgramCache::prepare(pending.program);
+  glLinkProgram(pending.program);
+  return pending;
+}
+
+bool ResourceLoader::shaderReady(const PendingShader& pending) {
+  if (!parallelCompile()) {
+    return true;
+  }
+
+  int32 done;
+  glGetProgramiv(pending.program, GL_COMPLETION_STATUS_ARB, &done);
+  return done != GL_FALSE;
+}
+
+Shader* ResourceLoader::finishShader(const PendingShader& pending) {
+  BELLUM_PROFILE_SCOPE("ResourceLoader::finishShader");
+
+  uint32 program = pending.program;
+  if (pending.vertex_shader != 0) {
+    checkCompileStatus(pending, pending.vertex_shader);
+    checkCompileStatus(pending, pending.fragment_shader);
+    linkShaderProgram(pending);
+    ProgramCache::store(pending.binary_key, program);
+
+    // the linked program keeps everything it needs
+    glDetachShader(program, pending.vertex_shader);
+    glDetachShader(program, pending.fragment_shader);
+    glDeleteShader(pending.vertex_shader);
+    glDeleteShader(pending.fragment_shader);
+  }
+
+  Shader::UniformMap uniforms;
+  for (auto& name : pending.uniform_names) {
+    uniforms.insert(std::make_pair(name, Shader::Uniform{name, -1}));
+  }
 
   glUseProgram(program);
   // bind uniforms
   for (auto& kv : uniforms) {
     int32 location = glGetUniformLocation(program, kv.first.c_str());
-    if (location == -1) {
+    if (location == -1 && pending.require_uniforms) {
+      glUseProgram(0);
+      glDeleteProgram(program);
       throw Shader::BindUniformException{Formatter::str("Could not bind uniform '", kv.first, "'")};
     }
     kv.second.location = location;
@@ -73,18 +250,74 @@ Shader* ResourceLoader::loadShader(const std::string& vertexShaderAsset,
   glUseProgram(0);
 
   Application::instance()->logger()->info("Loaded shader vs: '",
-                                             vertexShaderAsset, "' fs: '",
-                                             fragmentShaderAsset, "'");
+                                             pending.vertex_asset, "' fs: '",
+                                             pending.fragment_asset, "'");
 
   Shader* shader = new Shader{0, program, uniforms};
-  resources_.push_back(std::unique_ptr<Shader>{shader});
+  if (GLEW_ARB_get_program_binary) {
+    int32 length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    shader->gpu_bytes_ = static_cast<uint64>(length);
+  }
   return shader;
 }
 
-void ResourceLoader::compileShader(const std::string& source, uint32 type, uint32 program) {
+void ResourceLoader::deleteShader(const PendingShader& pending) {
+  if (pending.vertex_shader != 0) {
+    glDeleteShader(pending.vertex_shader);
+    glDeleteShader(pending.fragment_shader);
+  }
+  glDeleteProgram(pending.program);
+}
+
+void ResourceLoader::finishCompiling(double end) {
+  for (auto it = compiling_.begin(); it != compiling_.end();) {
+    if (!shaderReady(it->shader)) {
+      ++it;
+      continue;
+    }
+
+    try {
+      // two loads of the same shader raced, the first one to finish wins
+      auto cached = cache_.find(it->cache_key);
+      if (cached != cache_.end()) {
+        deleteShader(it->shader);
+        cached->second.last_used = ++cache_clock_;
+        it->promise->set_value(std::static_pointer_cast<Shader>(cached->second.resource));
+      } else {
+        std::shared_ptr<Shader> shader{finishShader(it->shader)};
+        addToCache(it->cache_key, shader);
+        it->promise->set_value(shader);
+      }
+    } catch (...) {
+      it->promise->set_exception(std::current_exception());
+    }
+
+    it = compiling_.erase(it);
+    if (Time::currentMilliseconds() >= end) {
+      break;
+    }
+  }
+}
+
+bool ResourceLoader::parallelCompile() {
+  // KHR_parallel_shader_compile shares its tokens with the ARB extension GLEW knows about
+  static bool supported = []() {
+    if (!GLEW_ARB_parallel_shader_compile) {
+      return false;
+    }
+    // let the driver pick the number of compiler threads
+    glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+    return true;
+  }();
+  return supported;
+}
+
+uint32 ResourceLoader::compileShader(const std::string& source, uint32 type, uint32 program) {
   uint32 shader = glCreateShader(type);
 
   if (shader == 0) {
+    glDeleteProgram(program);
     throw Shader::CompilationException{};
   }
 
@@ -94,48 +327,55 @@ void ResourceLoader::compileShader(const std::string& source, uint32 type, uint3
   lengths[0] = source.size();
   glShaderSource(shader, 1, sources, lengths);
   glCompileShader(shader);
+  glAttachShader(program, shader);
+  return shader;
+}
 
+void ResourceLoader::checkCompileStatus(const PendingShader& pending, uint32 shader) {
   int32 success;
   glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
   if (!success) {
     char info[1024];
     glGetShaderInfoLog(shader, sizeof(info), nullptr, info);
-    std::cerr << info << std::endl;
+    Application::instance()->logger()->error(info);
 
-    glDeleteProgram(program);
+    deleteShader(pending);
     throw Shader::CompilationException{};
   }
-
-  glAttachShader(program, shader);
 }
 
-void ResourceLoader::linkShaderProgram(uint32 program) {
-  glLinkProgram(program);
+void ResourceLoader::linkShaderProgram(const PendingShader& pending) {
+  uint32 program = pending.program;
   int32 success;
   glGetProgramiv(program, GL_LINK_STATUS, &success);
 
   if (success == GL_FALSE) {
     char info[1024];
     glGetProgramInfoLog(program, sizeof(info), nullptr, info);
-    std::cerr << info << std::endl;
+    Application::instance()->logger()->error(info);
 
-    glDeleteProgram(program);
+    deleteShader(pending);
     throw Shader::LinkException{};
   }
 
+#ifndef NDEBUG
+  // validation checks against the current GL state and is slow, release builds skip it
   glValidateProgram(program);
   glGetProgramiv(program, GL_VALIDATE_STATUS, &success);
   if (success == GL_FALSE) {
     char info[1024];
     glGetProgramInfoLog(program, sizeof(info), nullptr, info);
-    std::cerr << info << std::endl;
+    Application::instance()->logger()->error(info);
 
-    glDeleteProgram(program);
+    deleteShader(pending);
     throw Shader::LinkException{};
   }
+#endif
 }
 
 std::string ResourceLoader::loadTextAsset(const std::string& asset) {
+  BELLUM_PROFILE_SCOPE("ResourceLoader::loadTextAsset");
+
   std::string path = getAssetPath(asset);
   std::ifstream in{path, std::ios::binary};
   if (!in.is_open()) {
@@ -152,12 +392,169 @@ std::string ResourceLoader::loadTextAsset(const std::string& asset) {
   return ss.str();
 }
 
+std::future<std::string> ResourceLoader::loadTextAssetAsync(const std::string& asset) {
+  return workers().submit([asset]() {
+    return loadTextAsset(asset);
+  });
+}
+
+std::string ResourceLoader::shaderKey(const std::string& vertexShaderAsset,
+                                      const std::string& fragmentShaderAsset,
+                                      const BindingInfo& bindingInfo,
+                                      const std::vector<std::string>& uniformNames) {
+  std::stringstream key;
+  key << vertexShaderAsset << '|' << fragmentShaderAsset << '|';
+  for (const auto& ap : bindingInfo.attribute_pointers) {
+    key << static_cast<int32>(ap.kind) << ':' << ap.location << ',';
+  }
+  key << '|';
+  for (const auto& name : uniformNames) {
+    key << name << ',';
+  }
+  return key.str();
+}
+
+std::shared_ptr<Resource> ResourceLoader::findCached(const std::string& key) {
+  auto it = cache_.find(key);
+  if (it == cache_.end()) {
+    cache_stats_.misses++;
+    return nullptr;
+  }
+
+  cache_stats_.hits++;
+  it->second.last_used = ++cache_clock_;
+  return it->second.resource;
+}
+
+void ResourceLoader::addToCache(const std::string& key, std::shared_ptr<Resource> resource) {
+  CacheEntry entry{std::move(resource), 0, 0, ++cache_clock_};
+  entry.cpu_bytes = entry.resource->cpuBytes();
+  entry.gpu_bytes = entry.resource->gpuBytes();
+
+  cache_stats_.entries++;
+  cache_stats_.cpu_bytes += entry.cpu_bytes;
+  cache_stats_.gpu_bytes += entry.gpu_bytes;
+  cache_.emplace(key, std::move(entry));
+
+  trimCache();
+}
+
+void ResourceLoader::trimCache() {
+  while (cache_stats_.cpu_bytes > cache_cpu_budget_ || cache_stats_.gpu_bytes > cache_gpu_budget_) {
+    // caches stay small, a linear scan for the oldest unused entry is cheap enough
+    auto victim = cache_.end();
+    for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+      if (it->second.resource.use_count() == 1 &&
+          (victim == cache_.end() || it->second.last_used < victim->second.last_used)) {
+        victim = it;
+      }
+    }
+
+    // everything left is in use
+    if (victim == cache_.end()) {
+      return;
+    }
+
+    victim->second.resource->dispose();
+    cache_stats_.entries--;
+    cache_stats_.cpu_bytes -= victim->second.cpu_bytes;
+    cache_stats_.gpu_bytes -= victim->second.gpu_bytes;
+    cache_stats_.evictions++;
+    cache_.erase(victim);
+  }
+}
+
+void ResourceLoader::setCacheBudget(uint64 cpuBytes, uint64 gpuBytes) {
+  cache_cpu_budget_ = cpuBytes;
+  cache_gpu_budget_ = gpuBytes;
+  trimCache();
+}
+
+ResourceLoader::CacheStats ResourceLoader::cacheStats() {
+  CacheStats stats = cache_stats_;
+  stats.unused = 0;
+  for (const auto& kv : cache_) {
+    if (kv.second.resource.use_count() == 1) {
+      stats.unused++;
+    }
+  }
+  return stats;
+}
+
+ThreadPool& ResourceLoader::workers() {
+  // only the GL thread starts loads, no need to guard the first use
+  if (workers_ == nullptr) {
+    workers_ = std::make_unique<ThreadPool>();
+  }
+  return *workers_;
+}
+
+void ResourceLoader::queueFinalization(std::function<void()> job) {
+  std::lock_guard<std::mutex> lock{pending_mutex_};
+  pending_.push_back(std::move(job));
+}
+
+uint32 ResourceLoader::finalizePending(double budgetMs) {
+  BELLUM_PROFILE_SCOPE("ResourceLoader::finalizePending");
+
+  double end = Time::currentMilliseconds() + budgetMs;
+  trimCache();
+  finishCompiling(end);
+
+  while (true) {
+    std::function<void()> job;
+    {
+      std::lock_guard<std::mutex> lock{pending_mutex_};
+      if (pending_.empty()) {
+        break;
+      }
+      job = std::move(pending_.front());
+      pending_.pop_front();
+    }
+
+    job();
+
+    if (Time::currentMilliseconds() >= end) {
+      break;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock{pending_mutex_};
+  return static_cast<uint32>(pending_.size() + compiling_.size());
+}
+
+uint64 ResourceLoader::gpuMemoryEstimate() {
+  uint64 total = 0;
+  for (const auto& resource : resources_) {
+    total += resource->gpuBytes();
+  }
+  return total + cache_stats_.gpu_bytes;
+}
+
 void ResourceLoader::disposeAll() {
+  // loads still in flight are abandoned, their futures report a broken promise
+  workers_.reset();
+  {
+    std::lock_guard<std::mutex> lock{pending_mutex_};
+    pending_.clear();
+  }
+  for (auto& compiling : compiling_) {
+    deleteShader(compiling.shader);
+  }
+  compiling_.clear();
+
   for (auto& resource : resources_) {
     resource->dispose();
   }
   resources_.clear();
 
+  // handles still held elsewhere outlive the GL objects from here on
+  for (auto& kv : cache_) {
+    kv.second.resource->dispose();
+  }
+  cache_.clear();
+  cache_stats_ = {};
+
   Application::instance()->logger()->info("Released all resources");
 }
 
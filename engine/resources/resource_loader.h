@@ -1,43 +1,159 @@
 #ifndef __BELLUM_RESOURCE_LOADER_H__
 #define __BELLUM_RESOURCE_LOADER_H__
 
+#include <deque>
+#include <future>
+#include <limits>
+#include <mutex>
 #include <unordered_map>
 #include "../common.h"
+#include "../common/thread_pool.h"
 #include "binding_info.h"
 #include "resource.h"
 
 namespace bellum {
 
 class Shader;
+class ShaderVariants;
 class Mesh;
 
 class ResourceLoader {
   friend class StandaloneApplication;
   friend class MeshFactory;
+  friend class ShaderVariants;
 
 public:
 
   DEFINE_EXCEPTION(AssetNotFoundException, "Asset not found");
   DEFINE_EXCEPTION(MakeMeshException, "Failed to create a new mesh");
 
-  static Shader* loadShader(const std::string& vertexShaderAsset,
+  struct CacheStats {
+    uint32 entries;
+    // entries only the cache holds on to, the ones eviction may pick
+    uint32 unused;
+    uint64 cpu_bytes;
+    uint64 gpu_bytes;
+    uint64 hits;
+    uint64 misses;
+    uint64 evictions;
+  };
+
+  // Shaders are cached by their assets, bindings and uniforms, loading the same combination again
+  // returns the same shader
+  static std::shared_ptr<Shader> loadShader(const std::string& vertexShaderAsset,
                             const std::string& fragmentShaderAsset,
                             const BindingInfo& bindingInfo,
                             const std::vector<std::string>& uniformNames = {});
+  // Reads the sources once, variants are compiled as they are asked for. Loading the same
+  // combination again returns the same variants while any handle to them is alive.
+  static std::shared_ptr<ShaderVariants> loadShaderVariants(
+    const std::string& vertexShaderAsset,
+    const std::string& fragmentShaderAsset,
+    const BindingInfo& bindingInfo,
+    const std::vector<std::string>& uniformNames = {});
   static std::string loadTextAsset(const std::string& asset);
   static Mesh* makeEmptyMesh(const BindingInfo& bindingInfo);
 
+  // Read the sources on a worker thread, compiling and linking is queued for finalizePending on
+  // the GL thread. Poll the future there rather than waiting on it, it can't complete before the
+  // next finalizePending call. With parallel shader compilation the driver works on all submitted
+  // shaders at once and each future completes as soon as its program is linked.
+  static std::future<std::shared_ptr<Shader>> loadShaderAsync(
+    const std::string& vertexShaderAsset,
+    const std::string& fragmentShaderAsset,
+    const BindingInfo& bindingInfo,
+    const std::vector<std::string>& uniformNames = {});
+  static std::future<std::string> loadTextAssetAsync(const std::string& asset);
+
+  // Completes the shaders the driver finished compiling, then runs GL work queued by async loads
+  // on the calling thread. Both stop once 'budgetMs' have passed, but each does at least one
+  // shader and job. Returns the number of jobs and shaders left.
+  static uint32 finalizePending(double budgetMs);
+
+  // Sum of the driver memory estimates of all loaded resources
+  static uint64 gpuMemoryEstimate();
+
+  // Once the cached resources exceed either budget, the least recently loaded ones nobody holds a
+  // handle to are disposed. Eviction runs on the GL thread in finalizePending and after loads.
+  static void setCacheBudget(uint64 cpuBytes, uint64 gpuBytes);
+  static CacheStats cacheStats();
+
 private:
+  struct CacheEntry {
+    std::shared_ptr<Resource> resource;
+    uint64 cpu_bytes;
+    uint64 gpu_bytes;
+    uint64 last_used;
+  };
+
+  // A program submitted to the driver that may still be compiling
+  struct PendingShader {
+    std::string vertex_asset;
+    std::string fragment_asset;
+    std::vector<std::string> uniform_names;
+    // variants may compile uniforms out, those stay at location -1
+    bool require_uniforms;
+    uint64 binary_key;
+    uint32 program;
+    // 0 for programs loaded from a binary
+    uint32 vertex_shader;
+    uint32 fragment_shader;
+  };
+
+  struct CompilingShader {
+    PendingShader shader;
+    std::string cache_key;
+    std::shared_ptr<std::promise<std::shared_ptr<Shader>>> promise;
+  };
+
   static std::string kParentDirectory;
 
   ResourceLoader() {};
 
   static std::string getAssetPath(const std::string& asset);
-  static void compileShader(const std::string& source, uint32 type, uint32 program);
-  static void linkShaderProgram(uint32 program);
+  static uint32 compileShader(const std::string& source, uint32 type, uint32 program);
+  static void checkCompileStatus(const PendingShader& pending, uint32 shader);
+  static void linkShaderProgram(const PendingShader& pending);
+  static bool parallelCompile();
+  // Compiling and linking return right away with parallel compilation, the driver works on the
+  // program until shaderReady
+  static PendingShader beginShader(const std::string& vertexShaderAsset,
+                                   const std::string& vertexShaderSource,
+                                   const std::string& fragmentShaderAsset,
+                                   const std::string& fragmentShaderSource,
+                                   const BindingInfo& bindingInfo,
+                                   const std::vector<std::string>& uniformNames,
+                                   bool requireUniforms = true);
+  static bool shaderReady(const PendingShader& pending);
+  // Blocks until the driver is done, throws if compiling or linking failed
+  static Shader* finishShader(const PendingShader& pending);
+  static void deleteShader(const PendingShader& pending);
+  // Completes linked shaders until Time::currentMilliseconds reaches 'end'
+  static void finishCompiling(double end);
+  static std::string shaderKey(const std::string& vertexShaderAsset,
+                               const std::string& fragmentShaderAsset,
+                               const BindingInfo& bindingInfo,
+                               const std::vector<std::string>& uniformNames);
+  static std::shared_ptr<Shader> loadShaderVariant(const ShaderVariants& variants, uint32 mask);
+  static std::shared_ptr<Resource> findCached(const std::string& key);
+  static void addToCache(const std::string& key, std::shared_ptr<Resource> resource);
+  static void trimCache();
+  static ThreadPool& workers();
+  static void queueFinalization(std::function<void()> job);
   static void disposeAll();
 
   static std::vector<std::unique_ptr<Resource>> resources_;
+  static std::unordered_map<std::string, CacheEntry> cache_;
+  // compiled variants live in cache_, the sets only as long as someone uses them
+  static std::unordered_map<std::string, std::weak_ptr<ShaderVariants>> variant_sets_;
+  static CacheStats cache_stats_;
+  static uint64 cache_clock_;
+  static uint64 cache_cpu_budget_;
+  static uint64 cache_gpu_budget_;
+  static std::unique_ptr<ThreadPool> workers_;
+  static std::mutex pending_mutex_;
+  static std::deque<std::function<void()>> pending_;
+  static std::vector<CompilingShader> compiling_;
 };
 
 }
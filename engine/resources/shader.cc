@@ -1,57 +1,72 @@
 #include "shader.h"
 #include <GL/glew.h>
+#include "../render/render_stats.h"
 
 namespace bellum {
 
 Shader::Shader(uint8 pass, uint32 program, UniformMap uniforms)
-  : pass_(pass), program_(program), uniforms_(uniforms) {}
+  : pass_(pass), program_(program), uniforms_(uniforms), gpu_bytes_(0) {}
+
+uint64 Shader::cpuBytes() const {
+  uint64 total = sizeof(Shader);
+  for (const auto& kv : uniforms_) {
+    total += sizeof(kv) + kv.first.capacity() + kv.second.name.capacity();
+  }
+  return total;
+}
+
+int32 Shader::uploadLocation(const std::string& name) {
+  RenderStats::add(RenderStats::Counter::UNIFORM_UPLOADS);
+  return uniforms_[name].location;
+}
 
 void Shader::setUniform(const std::string& name, float value) {
-  int32 location = uniforms_[name].location;
+  int32 location = uploadLocation(name);
   glUniform1f(location, value);
 }
 
 void Shader::setUniform(const std::string& name, const std::vector<float>& value) {
-  int32 location = uniforms_[name].location;
+  int32 location = uploadLocation(name);
   glUniform1fv(location, value.size(), value.data());
 }
 
 void Shader::setUniform(const std::string& name, int32 value) {
-  int32 location = uniforms_[name].location;
+  int32 location = uploadLocation(name);
   glUniform1i(location, value);
 }
 
 void Shader::setUniform(const std::string& name, const Matrix4& value) {
-  int32 location = uniforms_[name].location;
+  int32 location = uploadLocation(name);
   glUniformMatrix4fv(location, 1, GL_FALSE, value.data.data());
 }
 
 void Shader::setUniform(const std::string& name, const Vector2& value) {
-  int32 location = uniforms_[name].location;
+  int32 location = uploadLocation(name);
   glUniform2f(location, value.x, value.y);
 }
 
 void Shader::setUniform(const std::string& name, const Vector3& value) {
-  int32 location = uniforms_[name].location;
+  int32 location = uploadLocation(name);
   glUniform3f(location, value.x, value.y, value.z);
 }
 
 void Shader::setUniform(const std::string& name, const Vector4& value) {
-  int32 location = uniforms_[name].location;
+  int32 location = uploadLocation(name);
   glUniform4f(location, value.x, value.y, value.z, value.w);
 }
 
 void Shader::setUniform(const std::string& name, const Color& value) {
-  int32 location = uniforms_[name].location;
+  int32 location = uploadLocation(name);
   glUniform4f(location, value.r, value.g, value.b, value.a);
 }
 
 void Shader::setUniform(const std::string& name, bool value) {
-  int32 location = uniforms_[name].location;
+  int32 location = uploadLocation(name);
   glUniform1i(location, value);
 }
 
 void Shader::bind() {
+  RenderStats::add(RenderStats::Counter::PROGRAM_BINDS);
   glUseProgram(program_);
 }
 
@@ -18,11 +18,19 @@ class Shader : public Resource {
   friend class StandaloneApplication;
 
 public:
+  BELLUM_TRACK_MEMORY(SHADER)
+
   DEFINE_EXCEPTION(CreateException, "Failed to create a new shader program");
   DEFINE_EXCEPTION(CompilationException, "Failed to compile shader");
   DEFINE_EXCEPTION(LinkException, "Failed to link shader");
   DEFINE_EXCEPTION(BindUniformException, "Could not bind uniform");
 
+  uint64 gpuBytes() const override {
+    return gpu_bytes_;
+  }
+
+  uint64 cpuBytes() const override;
+
 protected:
   void dispose() override;
 
@@ -45,12 +53,15 @@ private:
   void setUniform(const std::string& name, const Matrix4& value);
   void setUniform(const std::string& name, const Color& value);
   void setUniform(const std::string& name, bool value);
+  // Location to upload the uniform 'name' to, counts the upload in RenderStats
+  int32 uploadLocation(const std::string& name);
   void bind();
   void release();
 
   uint8 pass_;
   uint32 program_;
   UniformMap uniforms_;
+  uint64 gpu_bytes_;
 };
 
 }
@@ -0,0 +1,115 @@
+#include "shader_variants.h"
+#include <algorithm>
+#include "resource_loader.h"
+#include "shader.h"
+
+namespace bellum {
+
+constexpr uint32 ShaderVariants::kMaxKeywords;
+
+ShaderVariants::ShaderVariants(const std::string& vertexShaderAsset,
+                               const std::string& vertexShaderSource,
+                               const std::string& fragmentShaderAsset,
+                               const std::string& fragmentShaderSource,
+                               const BindingInfo& bindingInfo,
+                               const std::vector<std::string>& uniformNames)
+  : vertex_asset_(vertexShaderAsset),
+    vertex_source_(vertexShaderSource),
+    fragment_asset_(fragmentShaderAsset),
+    fragment_source_(fragmentShaderSource),
+    binding_info_(bindingInfo),
+    uniform_names_(uniformNames) {
+  parseKeywords(vertex_source_);
+  parseKeywords(fragment_source_);
+
+  if (keywords_.size() > kMaxKeywords) {
+    throw KeywordException{Formatter::str("'", vertex_asset_, "' and '", fragment_asset_,
+                                          "' declare ", keywords_.size(), " keywords, at most ",
+                                          kMaxKeywords, " are supported")};
+  }
+
+  variants_.resize(1u << keywords_.size());
+}
+
+void ShaderVariants::parseKeywords(const std::string& source) {
+  std::istringstream lines{source};
+  std::string line;
+  while (std::getline(lines, line)) {
+    std::istringstream tokens{line};
+    std::string directive, pragma;
+    if (!(tokens >> directive >> pragma) || directive != "#pragma" || pragma != "keywords") {
+      continue;
+    }
+
+    // both stages usually declare the same keywords, each gets one bit
+    std::string keyword;
+    while (tokens >> keyword) {
+      if (std::find(keywords_.begin(), keywords_.end(), keyword) == keywords_.end()) {
+        keywords_.push_back(keyword);
+      }
+    }
+  }
+}
+
+uint32 ShaderVariants::keywordMask(const std::string& keyword) const {
+  auto it = std::find(keywords_.begin(), keywords_.end(), keyword);
+  if (it == keywords_.end()) {
+    throw KeywordException{Formatter::str("Keyword '", keyword, "' isn't declared by '",
+                                          vertex_asset_, "' or '", fragment_asset_, "'")};
+  }
+  return 1u << static_cast<uint32>(it - keywords_.begin());
+}
+
+uint32 ShaderVariants::keywordMask(std::initializer_list<std::string> keywords) const {
+  uint32 mask = 0;
+  for (const auto& keyword : keywords) {
+    mask |= keywordMask(keyword);
+  }
+  return mask;
+}
+
+const std::shared_ptr<Shader>& ShaderVariants::variant(uint32 mask) {
+  if (mask >= variants_.size()) {
+    throw KeywordException{Formatter::str("Keyword mask ", mask, " is out of range")};
+  }
+
+  std::shared_ptr<Shader>& shader = variants_[mask];
+  if (shader == nullptr) {
+    shader = ResourceLoader::loadShaderVariant(*this, mask);
+  }
+  return shader;
+}
+
+uint32 ShaderVariants::compiledCount() const {
+  return static_cast<uint32>(std::count_if(variants_.begin(), variants_.end(),
+                                           [](const std::shared_ptr<Shader>& shader) {
+                                             return shader != nullptr;
+                                           }));
+}
+
+std::string ShaderVariants::variantSource(const std::string& source, uint32 mask) const {
+  std::string defines;
+  for (uint32 i = 0; i < keywords_.size(); i++) {
+    if (mask & (1u << i)) {
+      defines += "#define " + keywords_[i] + " 1\n";
+    }
+  }
+
+  // '#version' has to stay the first directive
+  size_t insert = 0;
+  size_t version = source.find("#version");
+  if (version != std::string::npos) {
+    size_t end = source.find('\n', version);
+    insert = end == std::string::npos ? source.size() : end + 1;
+  }
+
+  std::string result = source.substr(0, insert);
+  if (insert == source.size() && !result.empty() && result.back() != '\n') {
+    result += '\n';
+  }
+  result += defines;
+  result.append(source, insert, std::string::npos);
+  return result;
+}
+
+}
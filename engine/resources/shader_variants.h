@@ -0,0 +1,66 @@
+#ifndef BELLUM_SHADER_VARIANTS_H
+#define BELLUM_SHADER_VARIANTS_H
+
+#include <initializer_list>
+#include "../common.h"
+#include "binding_info.h"
+
+namespace bellum {
+
+class Shader;
+
+// A pair of shader sources compiled into one variant per set of keywords. The sources declare
+// their keywords on '#pragma keywords A B ...' lines, a variant gets a '#define' for each of its
+// keywords and is compiled the first time it's asked for. Bit i of a keyword mask stands for
+// keywords()[i]. Uniforms a variant compiles out are skipped instead of failing the load.
+class ShaderVariants {
+  friend class ResourceLoader;
+
+public:
+  BELLUM_TRACK_MEMORY(SHADER)
+
+  DEFINE_EXCEPTION(KeywordException, "Unknown shader keyword");
+
+  // Bounds the variant table to 256 entries
+  static constexpr uint32 kMaxKeywords = 8;
+
+  DELETE_COPY_AND_ASSIGN(ShaderVariants);
+
+  inline const std::vector<std::string>& keywords() const {
+    return keywords_;
+  }
+
+  uint32 keywordMask(const std::string& keyword) const;
+  uint32 keywordMask(std::initializer_list<std::string> keywords) const;
+
+  // Compiles the variant on first use, later calls are a lookup. Only call on the GL thread.
+  const std::shared_ptr<Shader>& variant(uint32 mask);
+
+  uint32 compiledCount() const;
+
+private:
+  ShaderVariants(const std::string& vertexShaderAsset,
+                 const std::string& vertexShaderSource,
+                 const std::string& fragmentShaderAsset,
+                 const std::string& fragmentShaderSource,
+                 const BindingInfo& bindingInfo,
+                 const std::vector<std::string>& uniformNames);
+
+  void parseKeywords(const std::string& source);
+  // 'source' with the defines of 'mask' after its '#version' line
+  std::string variantSource(const std::string& source, uint32 mask) const;
+
+  std::string vertex_asset_;
+  std::string vertex_source_;
+  std::string fragment_asset_;
+  std::string fragment_source_;
+  BindingInfo binding_info_;
+  std::vector<std::string> uniform_names_;
+  std::vector<std::string> keywords_;
+  // indexed by keyword mask, empty until compiled
+  std::vector<std::shared_ptr<Shader>> variants_;
+};
+
+}
+
+#endif
@@ -11,9 +11,13 @@ class Scene {
   friend class Node;
 
 public:
+  BELLUM_TRACK_MEMORY(SCENE)
+
   Scene()
     : root_(Node{1}) {}
 
+  virtual ~Scene() {}
+
   virtual void make() = 0;
 
   inline const std::vector<std::unique_ptr<Node>>& nodes() const {
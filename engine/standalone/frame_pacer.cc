@@ -0,0 +1,59 @@
+#include "frame_pacer.h"
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include "../timing.h"
+
+namespace bellum {
+
+FramePacer::FramePacer(FramePacing pacing, double targetFps)
+  : pacing_(pacing),
+    frame_time_(targetFps > 0.0 ? 1.0 / targetFps : 0.0),
+    next_frame_(0.0),
+    sleep_estimate_(0.005),
+    sleep_mean_(0.005),
+    sleep_m2_(0.0),
+    sleep_count_(1) {}
+
+void FramePacer::wait() {
+  if (pacing_ != FramePacing::TARGET_FPS || frame_time_ <= 0.0) {
+    return;
+  }
+
+  double now = Time::currentSeconds();
+  if (next_frame_ <= 0.0) {
+    next_frame_ = now;
+  }
+
+  next_frame_ += frame_time_;
+  if (next_frame_ <= now) {
+    // more than a frame behind, start over instead of rushing the following frames
+    next_frame_ = now;
+    return;
+  }
+
+  preciseSleep(next_frame_ - now);
+}
+
+void FramePacer::preciseSleep(double seconds) {
+  double end = Time::currentSeconds() + seconds;
+
+  // sleep in small steps while the remaining time safely exceeds the sleep overshoot
+  while (seconds > sleep_estimate_) {
+    double start = Time::currentSeconds();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    double observed = Time::currentSeconds() - start;
+    seconds -= observed;
+
+    sleep_count_++;
+    double delta = observed - sleep_mean_;
+    sleep_mean_ += delta / sleep_count_;
+    sleep_m2_ += delta * (observed - sleep_mean_);
+    sleep_estimate_ = sleep_mean_ + std::sqrt(sleep_m2_ / (sleep_count_ - 1));
+  }
+
+  // spin for the rest
+  while (Time::currentSeconds() < end) {}
+}
+
+}
@@ -0,0 +1,42 @@
+#ifndef BELLUM_FRAME_PACER_H
+#define BELLUM_FRAME_PACER_H
+
+#include "../common.h"
+
+namespace bellum {
+
+enum class FramePacing {
+  UNCAPPED,
+  VSYNC,
+  TARGET_FPS
+};
+
+class FramePacer {
+public:
+  FramePacer(FramePacing pacing = FramePacing::UNCAPPED, double targetFps = 60.0);
+
+  inline FramePacing pacing() const {
+    return pacing_;
+  }
+
+  // Blocks until the next frame should start. Only waits when pacing to a target fps, vsync is
+  // left to the swap chain.
+  void wait();
+
+private:
+  void preciseSleep(double seconds);
+
+  FramePacing pacing_;
+  double frame_time_;
+  double next_frame_;
+
+  // Running statistics of how long a 1ms sleep actually takes, the scheduler granularity
+  double sleep_estimate_;
+  double sleep_mean_;
+  double sleep_m2_;
+  int64 sleep_count_;
+};
+
+}
+
+#endif
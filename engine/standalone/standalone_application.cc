@@ -1,9 +1,18 @@
+#include <chrono>
 #include <cstdlib>
 #include <sstream>
 #include <cstring>
+#include <cmath>
+#include "resources/program_cache.h"
 #include "resources/resource_loader.h"
 #include "standalone_application.h"
 #include "window.h"
+#include "frame_pacer.h"
+#include "../common/log_sink.h"
+#include "../input.h"
+#include "../profiling/frame_stats.h"
+#include "../profiling/profiler.h"
+#include "../random.h"
 #include "../timing.h"
 
 namespace bellum {
@@ -18,7 +27,17 @@ void StandaloneApplication::start(std::vector<std::string> args) {
   int32 width = 480;
   int32 height = 360;
   bool vsync = false;
+  bool lateLatch = false;
+  double targetFps = 60.0;
   double targetUps = 60.0;
+  std::string statsPath;
+  std::string tracePath;
+  std::string logPath;
+  std::string memoryPath;
+  std::string recordPath;
+  std::string replayPath;
+  std::string shaderCachePath = "shader_cache.bin";
+  uint64 seed = static_cast<uint64>(std::chrono::system_clock::now().time_since_epoch().count());
   {
     // parse '--x=y' arguments
     std::stringstream ss;
@@ -30,6 +49,39 @@ void StandaloneApplication::start(std::vector<std::string> args) {
       } else if (arg.compare(0, 9, "--height=") == 0) {
         ss.str(arg.substr(9));
         ss >> height;
+      } else if (arg.compare(0, 8, "--vsync=") == 0) {
+        ss.str(arg.substr(8));
+        ss >> vsync;
+      } else if (arg.compare(0, 13, "--late-latch=") == 0) {
+        ss.str(arg.substr(13));
+        ss >> lateLatch;
+      } else if (arg.compare(0, 6, "--fps=") == 0) {
+        ss.str(arg.substr(6));
+        ss >> targetFps;
+      } else if (arg.compare(0, 7, "--seed=") == 0) {
+        ss.str(arg.substr(7));
+        ss >> seed;
+      } else if (arg.compare(0, 8, "--stats=") == 0) {
+        statsPath = arg.substr(8);
+        continue;
+      } else if (arg.compare(0, 8, "--trace=") == 0) {
+        tracePath = arg.substr(8);
+        continue;
+      } else if (arg.compare(0, 9, "--memory=") == 0) {
+        memoryPath = arg.substr(9);
+        continue;
+      } else if (arg.compare(0, 11, "--log-file=") == 0) {
+        logPath = arg.substr(11);
+        continue;
+      } else if (arg.compare(0, 9, "--record=") == 0) {
+        recordPath = arg.substr(9);
+        continue;
+      } else if (arg.compare(0, 9, "--replay=") == 0) {
+        replayPath = arg.substr(9);
+        continue;
+      } else if (arg.compare(0, 15, "--shader-cache=") == 0) {
+        shaderCachePath = arg.substr(15);
+        continue;
       } else {
         logger_->error("Unknown option '", arg, "'");
         continue;
@@ -43,6 +95,15 @@ void StandaloneApplication::start(std::vector<std::string> args) {
     }
   }
 
+  if (!logPath.empty()) {
+    auto sink = std::make_unique<RotatingFileSink>(logPath);
+    if (sink->isOpen()) {
+      LogBackend::instance().addSink(std::move(sink));
+    } else {
+      logger_->error("Failed to open log file '", logPath, "'");
+    }
+  }
+
   double frameTime = 1.0 / targetUps;
   Time::setDeltaTime(static_cast<float>(frameTime));
   double currentTime;
@@ -53,47 +114,140 @@ void StandaloneApplication::start(std::vector<std::string> args) {
   double lastFpsUpdate = 0.0;
   int framesProcessed = 0;
 
+  FramePacing pacing = vsync ? FramePacing::VSYNC
+                              : targetFps > 0.0 ? FramePacing::TARGET_FPS
+                                                : FramePacing::UNCAPPED;
+  FramePacer pacer{pacing, targetFps};
+
+  if (!tracePath.empty()) {
+#ifdef BELLUM_PROFILE
+    Profiler::setThreadName("Main");
+    Profiler::setEnabled(true);
+#else
+    logger_->error("Built without BELLUM_PROFILE, '--trace' has no scopes to record");
+#endif
+  }
+
   window_ = std::make_unique<Window>(width, height);
 
-  logger_->info("Application started");
-  srand((uint32) Time::currentNanoseconds());
+  // a replay runs with the seed it was recorded with so the scene comes out the same
+  if (!replayPath.empty()) {
+    if (Input::startReplay(replayPath, seed)) {
+      logger_->info("Replaying input from '", replayPath, "'");
+    } else {
+      logger_->error("Failed to open input recording '", replayPath, "'");
+    }
+  } else if (!recordPath.empty()) {
+    if (Input::startRecording(recordPath, seed)) {
+      logger_->info("Recording input to '", recordPath, "'");
+    } else {
+      logger_->error("Failed to open '", recordPath, "' for recording input");
+    }
+  }
+
+  logger_->info("Application started, random seed ", seed);
+  Random::seed(seed);
   running_ = true;
 
   try {
     window_->show();
+    window_->setVsync(pacing == FramePacing::VSYNC);
+    // an empty '--shader-cache=' compiles every shader from source
+    if (!shaderCachePath.empty()) {
+      ProgramCache::open(shaderCachePath);
+    }
     super::onStart();
 
     while (running_ && !window_->shouldClose()) {
       currentTime = Time::currentSeconds();
       elapsed = currentTime - previousTime;
+      FrameStats::Sample sample{};
+      BELLUM_PROFILE_SCOPE("Frame");
 
       // update
+      double phaseStart = Time::currentMilliseconds();
       lag += elapsed;
+      int32 steps = 0;
       while (lag > frameTime) {
-        super::update();
+        if (steps == kMaxUpdateSteps) {
+          // updates can't keep up with real time, drop the backlog instead of spiraling
+          lag = std::fmod(lag, frameTime);
+          break;
+        }
+
+        // input is sampled before the tick, from the window or a replay
         window_->update();
+        if (Input::replayFinished()) {
+          break;
+        }
+
+        super::update();
         lag -= frameTime;
+        steps++;
+      }
+      sample[FrameStats::Metric::UPDATE] = static_cast<float>(Time::currentMilliseconds() - phaseStart);
+
+      if (Input::replayFinished()) {
+        logger_->info("Replay finished");
+        running_ = false;
       }
 
+      ResourceLoader::finalizePending(kLoadBudgetMs);
+
       // render
+      phaseStart = Time::currentMilliseconds();
       lagOffset = static_cast<float>(lag / frameTime);
+      if (lateLatch) {
+        // the camera follows the cursor as of now rather than as of the last tick
+        window_->latch();
+        super::latch();
+      }
       super::render();
+      sample[FrameStats::Metric::RENDER] = static_cast<float>(Time::currentMilliseconds() - phaseStart);
 
       framesProcessed++;
       if (currentTime - lastFpsUpdate >= 1.0) {
         Time::setFps(framesProcessed);
         framesProcessed = 0;
+        lastFpsUpdate = currentTime;
       }
 
-      window_->render();
+      phaseStart = Time::currentMilliseconds();
+      {
+        BELLUM_PROFILE_SCOPE("Window::render");
+        window_->render();
+      }
+      sample[FrameStats::Metric::SWAP] = static_cast<float>(Time::currentMilliseconds() - phaseStart);
+      // the swap returning stands in for the photons, the display adds its own scanout on top
+      sample[FrameStats::Metric::INPUT] =
+        static_cast<float>((Time::currentSeconds() - Input::sampleTime()) * 1000.0);
       previousTime = currentTime;
+
+      pacer.wait();
+
+      sample[FrameStats::Metric::FRAME] =
+        static_cast<float>((Time::currentSeconds() - currentTime) * 1000.0);
+      sample.render = RenderStats::last();
+      sample[FrameStats::Metric::GPU] = Math::max(renderModule()->gpuTimer().lastFrameMs(), 0.0f);
+      FrameStats::record(sample);
     }
   } catch (const std::exception& e) {
     logger_->error(e.what());
   }
 
+  super::onExit();
+  Input::stopRecording();
+
+  if (!memoryPath.empty()) {
+    logger_->info("GPU memory estimate: ", ResourceLoader::gpuMemoryEstimate(), " bytes");
+  }
+  writeReports(statsPath, memoryPath, tracePath);
+
+  ProgramCache::close();
   ResourceLoader::disposeAll();
+
   logger_->info("Application exited");
+  LogBackend::instance().shutdown();
 }
 
 void StandaloneApplication::exit() {
@@ -9,6 +9,11 @@ class Window;
 
 class StandaloneApplication : public Application {
 public:
+  // Upper bound of fixed updates per frame, when exceeded the remaining lag is dropped
+  static constexpr int32 kMaxUpdateSteps = 5;
+  // Time per frame given to finishing async resource loads on the GL thread
+  static constexpr double kLoadBudgetMs = 2.0;
+
   StandaloneApplication();
   ~StandaloneApplication();
   DELETE_COPY_AND_ASSIGN(StandaloneApplication);
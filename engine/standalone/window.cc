@@ -3,6 +3,7 @@
 #include <GLFW/glfw3.h>
 #include <cstdlib>
 #include "input.h"
+#include "../application.h"
 
 namespace bellum {
 
@@ -32,7 +33,7 @@ void Window::show() {
 
   glfwMakeContextCurrent(glfw_window_);
   glfwSetErrorCallback([](int32 error, const char* description) {
-    std::cerr << description << std::endl;
+    Application::instance()->logger()->error("GLFW: ", description);
   });
   glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
 
@@ -40,10 +41,19 @@ void Window::show() {
   glewInit();
 }
 
+void Window::setVsync(bool enabled) {
+  glfwSwapInterval(enabled ? 1 : 0);
+}
+
 void Window::update() {
   Input::update();
 }
 
+void Window::latch() {
+  glfwPollEvents();
+  Input::latch();
+}
+
 void Window::render() {
   glfwSwapBuffers(glfw_window_);
   glfwPollEvents();
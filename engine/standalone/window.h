@@ -14,8 +14,11 @@ public:
   Window(int32 width, int32 height);
 
   void show();
+  void setVsync(bool enabled);
   bool shouldClose();
   void update();
+  // Picks up pending window events and samples the cursor again, see Input::latch
+  void latch();
   void render();
   void close();
 
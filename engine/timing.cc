@@ -1,25 +1,35 @@
 #include "timing.h"
-#include <GLFW/glfw3.h>
+#include <chrono>
 
 namespace bellum {
 
 int32 Time::fps_ = 0;
 float Time::dt_ = 0.0f;
 
+namespace {
+
+// Monotonic and independent of the window system, times are relative to the first call
+std::chrono::steady_clock::duration elapsed() {
+  static const auto start = std::chrono::steady_clock::now();
+  return std::chrono::steady_clock::now() - start;
+}
+
+}
+
 double Time::currentNanoseconds() {
-  return glfwGetTime() * 1000000000.0;
+  return std::chrono::duration<double, std::nano>(elapsed()).count();
 }
 
 double Time::currentMicroseconds() {
-  return glfwGetTime() * 1000000.0;
+  return std::chrono::duration<double, std::micro>(elapsed()).count();
 }
 
 double Time::currentMilliseconds() {
-  return glfwGetTime() * 1000.0;
+  return std::chrono::duration<double, std::milli>(elapsed()).count();
 }
 
 double Time::currentSeconds() {
-  return glfwGetTime();
+  return std::chrono::duration<double>(elapsed()).count();
 }
 
 }
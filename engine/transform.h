@@ -5,6 +5,7 @@
 #include "math/vector3.h"
 #include "math/quaternion.h"
 #include "math/matrix4.h"
+#include "math/affine3.h"
 
 namespace bellum {
 
@@ -34,11 +35,11 @@ public:
   }
 
   void rotate(const Vector3& euler, Space space = Space::WORLD) {
-    rotate(Quaternion::makeEuler(euler), space);
+    rotate(Quaternion::makeEuler<Precision::FAST>(euler), space);
   }
 
   void rotate(float angle, const Vector3& axis, Space space = Space::WORLD) {
-    rotate(Quaternion::makeAngleAxis(angle, axis), space);
+    rotate(Quaternion::makeAngleAxis<Precision::FAST>(angle, axis), space);
   }
 
   void rotate(const Quaternion& rotation, Space space = Space::WORLD) {
@@ -52,11 +53,11 @@ public:
   }
 
   inline Vector3 position() {
-    return parentMatrix() * position_;
+    return Affine3::multiplyPoint(parentMatrix(), position_);
   }
 
   inline void setPosition(const Vector3& position) {
-    position_ = parentMatrix().inverse() * position;
+    position_ = Affine3::multiplyPoint(parentMatrix().inversed(), position);
   }
 
   inline const Vector3& localPosition() {
@@ -114,7 +115,7 @@ public:
 
   inline void setParent(Transform* parent, bool worldPositionStays = false) {
     if (worldPositionStays) {
-      position_ = parent->localToWorld().inverse() * position_;
+      position_ = Affine3::multiplyPoint(parent->localToWorld().inversed(), position_);
       rotation_ = parent_->rotation().inverse() * rotation_;
       Vector3 ps = parent->scale();
       scale_ = {scale_.x / ps.x, scale_.y / ps.y, scale_.z / ps.z};
@@ -123,8 +124,8 @@ public:
     parent_ = parent;
   }
 
-  inline Matrix4 localToWorld() {
-    return parentMatrix() * Matrix4::makeTransformation(position_, rotation_, scale_);
+  inline Affine3 localToWorld() {
+    return parentMatrix() * Affine3::makeTransformation(position_, rotation_, scale_);
   }
 
   inline Vector3 forward() {
@@ -157,9 +158,9 @@ private:
   Vector3 scale_{1.0f, 1.0f, 1.0f};
 
   Transform* parent_ = nullptr;
-  Matrix4 parent_matrix_ = Matrix4::identity();
+  Affine3 parent_matrix_ = Affine3::identity();
 
-  inline Matrix4& parentMatrix() {
+  inline const Affine3& parentMatrix() {
     if (parent_ != nullptr) {
       parent_matrix_ = parent_->localToWorld();
     }
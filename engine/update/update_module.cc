@@ -1,6 +1,7 @@
 #include "../scene.h"
 #include "update_module.h"
 #include "../component.h"
+#include "../profiling/profiler.h"
 
 namespace bellum {
 
@@ -9,6 +10,8 @@ void UpdateModule::onStart(Scene* scene) {
 }
 
 void UpdateModule::update() {
+  BELLUM_PROFILE_SCOPE("UpdateModule::update");
+
   for (auto& node : scene_->nodes()) {
     updateNode(node.get());
   }